@@ -55,7 +55,13 @@ DEFINE_RESULT(struct {}, RSAError, RSAVerificationResult)
  * Generates an RSA key pair with the given parameters.
  *
  * The key pair must be initialized before calling this function.
- * This function populates the `key_pair` with a newly generated RSA public and private key.
+ * This function populates the `key_pair` with a newly generated RSA public and private key, whose modulus is exactly
+ * `bit_size` bits long.
+ *
+ * Keys of 512, 1024, 2048, 3072 and 4096 bits run their public and private operations on the fixed width types of
+ * the same size (`u2048`, ...), whose exponentiation keeps its Montgomery context on the stack and its power table on
+ * the thread's scratch arena, so once the arena has grown no operation touches the heap. Other sizes are supported
+ * too, through heap allocated BigUints.
  *
  * Example usage:
  *
@@ -126,4 +132,22 @@ RSASignResult rsa_sign_PKCS1v15(UInt8Array msg, RSAKeyPair key_pair, RSAHashes h
  */
 RSAVerificationResult rsa_verify_signature_PKCS1v15(UInt8Array msg, UInt8Array signature, RSAPublicKey pub);
 
+/**
+ * Verifies several RSA signatures using the PKCS1 v1.5 padding scheme.
+ *
+ * Gives the same results as calling `rsa_verify_signature_PKCS1v15` on each triple, but the public key operations run
+ * together through `biguint_pow_mod_batch`, which on CPUs supporting AVX-512 IFMA handles eight of them at once.
+ * Keys may differ in size, although signatures against keys of the same size batch best.
+ *
+ * WARNING: Only RSA_HASH_SHA256 is supported. Using any other hash algorithm will result in RSA_HasNotSupported.
+ *
+ * @param msgs       The original messages.
+ * @param signatures The signatures to verify, `signatures[i]` against `msgs[i]`.
+ * @param pubs       The RSA public keys, `pubs[i]` being the one for `signatures[i]`.
+ * @param count      The number of signatures.
+ * @param results    Where to store whether each signature is valid or the error found.
+ */
+void rsa_verify_signatures_PKCS1v15_batch(const UInt8Array *msgs, const UInt8Array *signatures,
+                                          const RSAPublicKey *pubs, int count, RSAVerificationResult *results);
+
 #endif
@@ -1,4 +1,9 @@
 #include <hashes/sha256.h>
+#include <primitive-types/u1024.h>
+#include <primitive-types/u2048.h>
+#include <primitive-types/u3072.h>
+#include <primitive-types/u4096.h>
+#include <primitive-types/u512.h>
 #include <rsa.h>
 
 #define e_const 65537
@@ -61,6 +66,9 @@ const RSAHashEntry hash_list[] = {
 
 void hash_msg(RSAHashes hasher, UInt8Array msg, UInt8Array *hash);
 int try_identify_hasher_by_oid(uint8_t *bytes, int size, RSAHashes *hasher);
+static RSAVerificationResult verify_encoded_msg(UInt8Array msg, uint8_t *em_bytes, int k);
+static void pow_mod_bytes(const uint8_t *in_bytes, int in_len, BigUint exponent, BigUint n, int k, uint8_t *out_bytes);
+static void random_full_width_prime(BigUint *a);
 
 // Generating a key pair consists of:
 // 1. generating two random prime number p,q
@@ -72,11 +80,12 @@ int try_identify_hasher_by_oid(uint8_t *bytes, int size, RSAHashes *hasher);
 void rsa_gen_key_pair(RSAKeyPair *key_pair) {
     int key_limbs_size = key_pair->bit_size / 64;
 
-    // prime numbers have to be half the size of the desired key to prevent multiplication overflows
+    // prime numbers have to be half the size of the desired key to prevent multiplication overflows, and their top
+    // bits are set so n is exactly bit_size bits long
     BigUint p = biguint_new_heap(key_limbs_size / 2);
     BigUint q = biguint_new_heap(key_limbs_size / 2);
-    biguint_random_prime(&p);
-    biguint_random_prime(&q);
+    random_full_width_prime(&p);
+    random_full_width_prime(&q);
 
     BigUint n = biguint_new_heap(key_limbs_size);
     biguint_mul(p, q, &n);
@@ -122,47 +131,33 @@ void rsa_gen_key_pair(RSAKeyPair *key_pair) {
 RSAEncryptResult rsa_encrypt_msg_PKCS1v15(UInt8Array msg, RSAPublicKey pub, UInt8Array *buf) {
     // k represents the length of n in bytes
     int k = (biguint_bits(pub.n) + 7) / 8;
-    int limbs_size = k / 8;
 
     // message too long
     if (msg.size > k - 11) {
         return Err(RSAEncryptResult, RSA_MessageTooLong);
     }
 
-    uint8_t *ps = malloc((k - msg.size - 3));
-    for (int j = 0; j < k - msg.size - 3; j++) {
-        uint8_t rand = 0;
-        while (rand == 0) {
-            rand = u8_random();
-        }
-        ps[j] = rand;
-    }
-    // EM = 0x00 || 0x02 || PS || 0x00 || M.
-    uint8_t *em_bytes = malloc(k);
+    buf->array = realloc(buf->array, k);
+    buf->size = k;
+
+    // EM = 0x00 || 0x02 || PS || 0x00 || M, built in the output buffer and encrypted in place
+    uint8_t *em_bytes = buf->array;
     int i = 0;
     em_bytes[i++] = 0x00;
     em_bytes[i++] = 0x02;
     for (int j = 0; j < (k - msg.size - 3); j++) {
-        em_bytes[i++] = ps[j];
+        uint8_t rand = 0;
+        while (rand == 0) {
+            rand = u8_random();
+        }
+        em_bytes[i++] = rand;
     }
     em_bytes[i++] = 0x00;
     for (int j = 0; j < msg.size; j++) {
         em_bytes[i++] = msg.array[j];
     }
 
-    BigUint em = biguint_new_heap(limbs_size);
-    biguint_from_bytes_big_endian(em_bytes, &em);
-
-    BigUint cipher = biguint_new_heap(limbs_size);
-    biguint_pow_mod(em, pub.e, pub.n, &cipher);
-
-    buf->array = realloc(buf->array, k);
-    buf->size = k;
-    biguint_get_bytes_big_endian(cipher, buf->array);
-
-    biguint_free(&em, &cipher);
-    free(ps);
-    free(em_bytes);
+    pow_mod_bytes(em_bytes, k, pub.e, pub.n, k, buf->array);
 
     return Ok(RSAEncryptResult, {});
 }
@@ -170,7 +165,6 @@ RSAEncryptResult rsa_encrypt_msg_PKCS1v15(UInt8Array msg, RSAPublicKey pub, UInt
 RSADecryptResult rsa_decrypt_msg_PKCS1v15(RSAKeyPair key_pair, UInt8Array cipher_bytes, UInt8Array *buf) {
     // k represents the length of n in bytes
     int k = (biguint_bits(key_pair.pub.n) + 7) / 8;
-    int limbs_size = k / 8;
 
     if (cipher_bytes.size > k) {
         return Err(RSADecryptResult, RSA_MessageTooLong);
@@ -180,24 +174,15 @@ RSADecryptResult rsa_decrypt_msg_PKCS1v15(RSAKeyPair key_pair, UInt8Array cipher
         return Err(RSADecryptResult, RSA_MessageTooShort);
     }
 
-    BigUint cipher = biguint_new_heap(limbs_size);
-    biguint_from_bytes_big_endian(cipher_bytes.array, &cipher);
-
-    BigUint em = biguint_new_heap(limbs_size);
-    biguint_pow_mod(cipher, key_pair.priv.d, key_pair.pub.n, &em);
-
     // EM = 0x00 || 0x02 || PS || 0x00 || M.
-    uint8_t *em_bytes = malloc(k);
-    biguint_get_bytes_big_endian(em, em_bytes);
-    biguint_free(&cipher, &em);
+    uint8_t em_bytes[k];
+    pow_mod_bytes(cipher_bytes.array, cipher_bytes.size, key_pair.priv.d, key_pair.pub.n, k, em_bytes);
 
     int i = 0;
     if (em_bytes[i++] != 0x00) {
-        free(em_bytes);
         return Err(RSADecryptResult, RSA_InvalidEncodedMessage);
     }
     if (em_bytes[i++] != 0x02) {
-        free(em_bytes);
         return Err(RSADecryptResult, RSA_InvalidEncodedMessage);
     }
     int ps_len = 0;
@@ -207,11 +192,9 @@ RSADecryptResult rsa_decrypt_msg_PKCS1v15(RSAKeyPair key_pair, UInt8Array cipher
         ps_len++;
     }
     if (ps_len < 8) {
-        free(em_bytes);
         return Err(RSADecryptResult, RSA_InvalidEncodedMessage);
     }
     if (byte != 0x00) {
-        free(em_bytes);
         return Err(RSADecryptResult, RSA_InvalidEncodedMessage);
     }
 
@@ -224,64 +207,40 @@ RSADecryptResult rsa_decrypt_msg_PKCS1v15(RSAKeyPair key_pair, UInt8Array cipher
     }
     buf->array[msg_size] = '\0';
 
-    free(em_bytes);
-
     return Ok(RSADecryptResult, {});
 };
 
 RSASignResult rsa_sign_PKCS1v15(UInt8Array msg_bytes, RSAKeyPair key_pair, RSAHashes hasher, UInt8Array *buf) {
     // k represents the length of n in bytes
     int k = (biguint_bits(key_pair.pub.n) + 7) / 8;
-    int limbs_size = k / 8;
 
     RSAHashEntry hash_entry = hash_list[hasher];
     if (hash_entry.supported == 0) {
         return Err(RSASignResult, RSA_HashNotSupported);
     }
 
-    UInt8Array msg_hash = {.array = malloc(hash_entry.hash_len), .size = hash_entry.hash_len};
-    hash_msg(hasher, msg_bytes, &msg_hash);
-
     int t_len = hash_entry.oid_size + hash_entry.hash_len;
-    uint8_t *t = malloc(hash_entry.oid_size + hash_entry.hash_len);
-
-    int m = 0;
-    for (; m < hash_entry.oid_size; m++)
-        t[m] = hash_entry.oid[m];
-    for (int j = 0; j < hash_entry.hash_len; j++)
-        t[m++] = msg_hash.array[j];
-
-    free(msg_hash.array);
-
     if (k < t_len + 11) {
-        free(t);
         return Err(RSASignResult, RSA_MessageTooShort);
     }
 
-    // EM = 0x00 || 0x01 || PS || 0x00 || T.
-    uint8_t *em_bytes = malloc(k);
+    buf->array = realloc(buf->array, k);
+    buf->size = k;
+
+    // EM = 0x00 || 0x01 || PS || 0x00 || T, where T = OID || H, built in the output buffer and signed in place
+    uint8_t *em_bytes = buf->array;
     int i = 0;
     em_bytes[i++] = 0x00;
     em_bytes[i++] = 0x01;
     for (; i < k - t_len - 1; i++)
         em_bytes[i] = 0xff;
     em_bytes[i++] = 0x00;
-    for (int j = 0; j < t_len; j++)
-        em_bytes[i++] = t[j];
-
-    BigUint em = biguint_new_heap(limbs_size);
-    biguint_from_bytes_big_endian(em_bytes, &em);
-
-    BigUint signature = biguint_new_heap(limbs_size);
-    biguint_pow_mod(em, key_pair.priv.d, key_pair.pub.n, &signature);
-
-    buf->array = realloc(buf->array, k);
-    buf->size = k;
-    biguint_get_bytes_big_endian(signature, buf->array);
+    for (int j = 0; j < hash_entry.oid_size; j++)
+        em_bytes[i++] = hash_entry.oid[j];
+    UInt8Array msg_hash = {.array = em_bytes + i, .size = hash_entry.hash_len};
+    hash_msg(hasher, msg_bytes, &msg_hash);
 
-    free(t);
-    free(em_bytes);
-    biguint_free(&signature, &em);
+    pow_mod_bytes(em_bytes, k, key_pair.priv.d, key_pair.pub.n, k, buf->array);
 
     return Ok(RSASignResult, {});
 }
@@ -289,33 +248,70 @@ RSASignResult rsa_sign_PKCS1v15(UInt8Array msg_bytes, RSAKeyPair key_pair, RSAHa
 RSAVerificationResult rsa_verify_signature_PKCS1v15(UInt8Array msg, UInt8Array signature_bytes, RSAPublicKey pub) {
     // k represents the length of n in bytes
     int k = (biguint_bits(pub.n) + 7) / 8;
-    int limbs_size = k / 8;
 
     if (signature_bytes.size < k) {
         return Err(RSAVerificationResult, RSA_InvalidSignature);
     }
 
-    BigUint signature = biguint_new_heap(limbs_size);
-    biguint_from_bytes_big_endian(signature_bytes.array, &signature);
+    uint8_t em_bytes[k];
+    pow_mod_bytes(signature_bytes.array, k, pub.e, pub.n, k, em_bytes);
 
-    BigUint em = biguint_new_heap(limbs_size);
-    biguint_pow_mod(signature, pub.e, pub.n, &em);
-    biguint_free(&signature);
+    return verify_encoded_msg(msg, em_bytes, k);
+};
 
-    // EM = 0x00 || 0x01 || PS || 0x00 || T.
-    uint8_t *em_bytes = malloc(k);
-    biguint_get_bytes_big_endian(em, em_bytes);
-    biguint_free(&em);
+void rsa_verify_signatures_PKCS1v15_batch(const UInt8Array *msgs, const UInt8Array *signatures,
+                                          const RSAPublicKey *pubs, int count, RSAVerificationResult *results) {
+    BigUint *bases = malloc(count * sizeof(BigUint));
+    BigUint *exponents = malloc(count * sizeof(BigUint));
+    BigUint *moduli = malloc(count * sizeof(BigUint));
+    BigUint *ems = malloc(count * sizeof(BigUint));
+
+    // signatures too short for their key are rejected upfront, and their slot left out of the batch
+    int batched = 0;
+    for (int i = 0; i < count; i++) {
+        int k = (biguint_bits(pubs[i].n) + 7) / 8;
+        if (signatures[i].size < k) {
+            results[i] = Err(RSAVerificationResult, RSA_InvalidSignature);
+            continue;
+        }
+
+        bases[batched] = biguint_new_heap((k + 7) / 8);
+        biguint_read_bytes_big_endian(signatures[i].array, k, &bases[batched]);
+        exponents[batched] = pubs[i].e;
+        moduli[batched] = pubs[i].n;
+        ems[batched] = biguint_new_heap((k + 7) / 8);
+        batched++;
+    }
+
+    biguint_pow_mod_batch(bases, exponents, moduli, ems, batched);
+
+    int j = 0;
+    for (int i = 0; i < count; i++) {
+        int k = (biguint_bits(pubs[i].n) + 7) / 8;
+        if (signatures[i].size < k)
+            continue;
+
+        uint8_t em_bytes[k];
+        biguint_write_bytes_big_endian(ems[j], em_bytes, k);
+        results[i] = verify_encoded_msg(msgs[i], em_bytes, k);
+        biguint_free(&bases[j], &ems[j]);
+        j++;
+    }
 
+    free(bases);
+    free(exponents);
+    free(moduli);
+    free(ems);
+}
+
+// checks that em_bytes, the k bytes of s^e mod n, are the PKCS1 v1.5 encoding of the hash of msg
+static RSAVerificationResult verify_encoded_msg(UInt8Array msg, uint8_t *em_bytes, int k) {
+    // EM = 0x00 || 0x01 || PS || 0x00 || T.
     int i = 0;
-    if (em_bytes[i++] != 0x00) {
-        free(em_bytes);
+    if (em_bytes[i++] != 0x00)
         return Err(RSAVerificationResult, RSA_InvalidSignature);
-    }
-    if (em_bytes[i++] != 0x01) {
-        free(em_bytes);
+    if (em_bytes[i++] != 0x01)
         return Err(RSAVerificationResult, RSA_InvalidSignature);
-    }
 
     int ps_len = 0;
     uint8_t byte = em_bytes[i++];
@@ -323,15 +319,11 @@ RSAVerificationResult rsa_verify_signature_PKCS1v15(UInt8Array msg, UInt8Array s
         byte = em_bytes[i++];
         ps_len++;
     }
-    if (ps_len < 8) {
-        free(em_bytes);
+    if (ps_len < 8)
         return Err(RSAVerificationResult, RSA_InvalidSignature);
-    }
 
-    if (byte != 0x00) {
-        free(em_bytes);
+    if (byte != 0x00)
         return Err(RSAVerificationResult, RSA_InvalidSignature);
-    }
 
     RSAHashes hasher;
 
@@ -343,37 +335,88 @@ RSAVerificationResult rsa_verify_signature_PKCS1v15(UInt8Array msg, UInt8Array s
         identified = try_identify_hasher_by_oid(hash_oid, j, &hasher);
     }
 
-    if (identified == 0) {
-        free(em_bytes);
+    if (identified == 0)
         return Err(RSAVerificationResult, RSA_InvalidSignature);
-    }
 
     RSAHashEntry hash_entry = hash_list[hasher];
-    if (hash_entry.supported == 0) {
-        free(em_bytes);
+    if (hash_entry.supported == 0)
         return Err(RSAVerificationResult, RSA_HashNotSupported);
-    }
 
     // the rest is the signature message hash
     int hash_size = hash_entry.hash_len;
-    uint8_t *decoded_msg_hash = malloc(hash_size);
-    for (int j = 0; j < hash_size; j++)
-        decoded_msg_hash[j] = em_bytes[i++];
+    if (k - i != hash_size)
+        return Err(RSAVerificationResult, RSA_InvalidSignature);
 
     // hash original message and verify they are the same
-    UInt8Array original_msg_hash = {.array = malloc(hash_size), .size = hash_size};
+    uint8_t original_hash[64]; // 64 is the max hash size
+    UInt8Array original_msg_hash = {.array = original_hash, .size = hash_size};
     hash_msg(hasher, msg, &original_msg_hash);
 
-    int cmp = memcmp(original_msg_hash.array, decoded_msg_hash, hash_size) != 0;
-    free(em_bytes);
-    free(original_msg_hash.array);
-    free(decoded_msg_hash);
+    int cmp = memcmp(original_hash, em_bytes + i, hash_size) != 0;
 
     if (cmp != 0)
         return Err(RSAVerificationResult, RSA_InvalidSignature);
 
     return Ok(RSAVerificationResult, {});
-};
+}
+
+// picks random odd numbers with their two top bits set until one is prime, the product of two such primes is twice as
+// long as them
+static void random_full_width_prime(BigUint *a) {
+    do {
+        biguint_random(a);
+        a->limbs[a->size - 1] |= 3ULL << 62;
+        a->limbs[0] |= 1;
+    } while (!biguint_is_prime(*a));
+}
+
+// out_bytes = in_bytes^exponent mod n, where in_bytes is a big endian number of in_len <= k bytes and out_bytes gets
+// the k bytes of the result, in_bytes is read whole before out_bytes is written so they may be the same buffer
+#define DEFINE_RSA_POW_MOD(NAME)                                                                                       \
+    static void pow_mod_bytes_##NAME(const uint8_t *in_bytes, int in_len, BigUint exponent, BigUint n,                 \
+                                     uint8_t *out_bytes) {                                                             \
+        NAME base;                                                                                                     \
+        NAME##_read_bytes_big_endian(in_bytes, in_len, &base);                                                         \
+        NAME result = NAME##_pow_mod(base, NAME##_from_biguint(exponent), NAME##_from_biguint(n));                     \
+        NAME##_write_bytes_big_endian(result, out_bytes, sizeof(NAME));                                                \
+    }
+
+DEFINE_RSA_POW_MOD(u512)
+DEFINE_RSA_POW_MOD(u1024)
+DEFINE_RSA_POW_MOD(u2048)
+DEFINE_RSA_POW_MOD(u3072)
+DEFINE_RSA_POW_MOD(u4096)
+
+// standard key sizes run on the fixed width types, with a stack montgomery context, other sizes on heap allocated
+// BigUints
+static void pow_mod_bytes(const uint8_t *in_bytes, int in_len, BigUint exponent, BigUint n, int k, uint8_t *out_bytes) {
+    switch (k) {
+    case 64:
+        pow_mod_bytes_u512(in_bytes, in_len, exponent, n, out_bytes);
+        return;
+    case 128:
+        pow_mod_bytes_u1024(in_bytes, in_len, exponent, n, out_bytes);
+        return;
+    case 256:
+        pow_mod_bytes_u2048(in_bytes, in_len, exponent, n, out_bytes);
+        return;
+    case 384:
+        pow_mod_bytes_u3072(in_bytes, in_len, exponent, n, out_bytes);
+        return;
+    case 512:
+        pow_mod_bytes_u4096(in_bytes, in_len, exponent, n, out_bytes);
+        return;
+    default:
+        break;
+    }
+
+    BigUint base = biguint_new_heap((k + 7) / 8);
+    BigUint result = biguint_new_heap((k + 7) / 8);
+    biguint_read_bytes_big_endian(in_bytes, in_len, &base);
+    biguint_pow_mod(base, exponent, n, &result);
+    biguint_write_bytes_big_endian(result, out_bytes, k);
+    biguint_free(&base, &result);
+}
 
 void hash_msg(RSAHashes hasher, UInt8Array msg, UInt8Array *buf) {
     switch (hasher) {
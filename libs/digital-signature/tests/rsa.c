@@ -146,6 +146,36 @@ void test_full_msg_exchange() {
     free(signature.array);
 }
 
+void test_verify_signatures_batch() {
+    RSAKeyPair alice = rsa_key_pair_new(512);
+    rsa_gen_key_pair(&alice);
+    RSAKeyPair john = rsa_key_pair_new(1024);
+    rsa_gen_key_pair(&john);
+
+    // more signatures than a batch lane count, from two keys of different sizes, with one tampered
+    char *texts[] = {"first", "second", "third", "fourth", "fifth", "sixth", "seventh", "eighth", "ninth", "tenth"};
+    int count = 10;
+    UInt8Array msgs[10], signatures[10];
+    RSAPublicKey pubs[10];
+    RSAVerificationResult results[10];
+    for (int i = 0; i < count; i++) {
+        RSAKeyPair key_pair = i % 3 == 0 ? john : alice;
+        msgs[i] = (UInt8Array){.array = (uint8_t *)texts[i], .size = strlen(texts[i])};
+        signatures[i] = (UInt8Array){};
+        pubs[i] = key_pair.pub;
+        RSASignResult res = rsa_sign_PKCS1v15(msgs[i], key_pair, RSA_HASH_SHA256, &signatures[i]);
+        assert_that(res.success == 1);
+    }
+    signatures[4].array[10] ^= 0xFF;
+
+    rsa_verify_signatures_PKCS1v15_batch(msgs, signatures, pubs, count, results);
+    for (int i = 0; i < count; i++) {
+        assert_that(results[i].success == (i != 4));
+        assert_that(results[i].success == rsa_verify_signature_PKCS1v15(msgs[i], signatures[i], pubs[i]).success);
+        free(signatures[i].array);
+    }
+}
+
 int main() {
     BEGIN_TEST()
     test(test_key_generation);
@@ -155,6 +185,7 @@ int main() {
     test(test_signing_msg_is_valid);
     test(test_signature_tampering);
     test(test_full_msg_exchange);
+    test(test_verify_signatures_batch);
     END_TEST()
 
     return 0;
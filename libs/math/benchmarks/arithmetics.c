@@ -0,0 +1,48 @@
+#include <math/arithmetics.h>
+#include <math/random.h>
+#include <utils/benchmark.h>
+
+void benchmark_gcd(int size) {
+    BigUint a = biguint_new_heap(size);
+    BigUint b = biguint_new_heap(size);
+    BigUint out = biguint_new_heap(size);
+    biguint_random(&a);
+    biguint_random(&b);
+    biguint_gcd(a, b, &out);
+    biguint_free(&a, &b, &out);
+}
+
+void benchmark_lcm(int size) {
+    BigUint a = biguint_new_heap(size);
+    BigUint b = biguint_new_heap(size);
+    BigUint out = biguint_new_heap(size * 2);
+    biguint_random(&a);
+    biguint_random(&b);
+    biguint_lcm(a, b, &out);
+    biguint_free(&a, &b, &out);
+}
+
+void benchmark_inverse_mod(int size) {
+    BigUint a = biguint_new_heap(size);
+    BigUint m = biguint_new_heap(size);
+    BigUint out = biguint_new_heap(size);
+    biguint_random(&a);
+    biguint_random(&m);
+    m.limbs[0] |= 1;
+    biguint_inverse_mod(a, m, &out);
+    biguint_free(&a, &m, &out);
+}
+
+int main() {
+    BEGIN_BENCHMARK()
+    benchmark("gcd 128 bits", benchmark_gcd, 10000, 2);
+    benchmark("gcd 256 bits", benchmark_gcd, 10000, 4);
+    benchmark("gcd 1024 bits", benchmark_gcd, 1000, 16);
+    benchmark("gcd 4096 bits", benchmark_gcd, 100, 64);
+    benchmark("lcm 1024 bits", benchmark_lcm, 1000, 16);
+    benchmark("inverse_mod 256 bits odd modulus", benchmark_inverse_mod, 10000, 4);
+    benchmark("inverse_mod 2048 bits odd modulus", benchmark_inverse_mod, 100, 32);
+    END_BENCHMARK()
+
+    return 0;
+}
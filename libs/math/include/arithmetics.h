@@ -1,7 +1,9 @@
 #ifndef ARITHMETICS_H
 #define ARITHMETICS_H
 
+#include <primitive-types/bigint.h>
 #include <primitive-types/biguint.h>
+#include <primitive-types/u256.h>
 
 /**
  * Computes the least common multiple between two number via the euclidean algorithm
@@ -10,8 +12,11 @@
  */
 void biguint_lcm(BigUint a, BigUint b, BigUint *out);
 
-// computes the greatest common divisor between a and b via the euclidean algorithm
-// https://en.wikipedia.org/wiki/Euclidean_algorithm
+// computes the greatest common divisor between a and b, via Lehmer's algorithm, which runs the euclidean algorithm on
+// the leading 62 bits and applies the steps to the full numbers in batches, finishing with a binary gcd once the
+// operands fit two limbs
+// https://en.wikipedia.org/wiki/Lehmer%27s_GCD_algorithm
+// https://en.wikipedia.org/wiki/Binary_GCD_algorithm
 void biguint_gcd(BigUint a, BigUint b, BigUint *out);
 
 typedef struct {
@@ -32,8 +37,38 @@ typedef struct {
 
 #define extended_euclidean_algorithm_free(str) biguint_free(&str.rk, &str.sk, &str.tk)
 
+/**
+ * Runs the Extended Euclidean Algorithm on `a` and `b`, as `biguint_extended_gcd` does, keeping the cofactors as
+ * unsigned values plus a sign: a negative cofactor `x` is stored wrapped around, as `2^(64 * size) - |x|`, so adding
+ * the modulus to it gives its positive residue.
+ *
+ * @param a   The first number.
+ * @param b   The second number.
+ * @param out Where to store gcd(a, b) and the cofactors.
+ */
 void biguint_extended_euclidean_algorithm(BigUint a, BigUint b, ExtendedEuclideanAlgorithm *out);
 
+/**
+ * Computes gcd(a, b) together with the cofactors `s` and `t` of Bezout's identity, `a * s + b * t = gcd(a, b)`.
+ *
+ * The cofactors are tracked as signed values all along, their sizes are bounded by `b / gcd` and `a / gcd`.
+ *
+ * @param a   The first number.
+ * @param b   The second number.
+ * @param gcd Pointer to store gcd(a, b).
+ * @param s   Pointer to store the cofactor of `a`.
+ * @param t   Pointer to store the cofactor of `b`, NULL if it's not needed, which saves half the work.
+ *
+ * @example
+ * ```
+ * // 161 * -1 + 28 * 6 = 7
+ * biguint_extended_gcd(a, b, &gcd, &s, &t);
+ * ```
+ *
+ * https://en.wikipedia.org/wiki/Extended_Euclidean_algorithm
+ */
+void biguint_extended_gcd(BigUint a, BigUint b, BigUint *gcd, BigInt *s, BigInt *t);
+
 /**
  * Computes the modular inverse of a number `a` modulo `b` using the modular version of the Extended Euclidean
  * Algorithm.
@@ -57,8 +92,65 @@ void biguint_extended_euclidean_algorithm(BigUint a, BigUint b, ExtendedEuclidea
  * biguint_inverse_mod(c, d, &inverse);  // `inverse` is now 0, since 2 and 4 are not coprime
  * ```
  *
+ * Odd moduli are handled by `biguint_inverse_mod_odd`.
+ *
  * https://en.wikipedia.org/wiki/Extended_Euclidean_algorithm#
  */
 void biguint_inverse_mod(BigUint a, BigUint b, BigUint *out);
 
+/**
+ * Computes the modular inverse of `a` modulo an odd `m` with Bernstein and Yang's safegcd.
+ *
+ * The inverse is found through divsteps, which only look at the low bits of the numbers, run 62 at a time on single
+ * words and applied to the full numbers through a signed 64-bit transition matrix. Their number only depends on the
+ * size of `m`, and none of them branches on the data, so for `a < m` the run time doesn't depend on the values.
+ * Bigger values of `a` are reduced modulo `m` first.
+ *
+ * If `a` has no inverse modulo `m`, `out` is set to zero.
+ *
+ * @param a   The number to invert.
+ * @param m   The modulus, which must be odd.
+ * @param out Pointer to the BigUint where the result will be stored.
+ *
+ * https://gcd.cr.yp.to/safegcd-20190413.pdf
+ */
+void biguint_inverse_mod_odd(BigUint a, BigUint m, BigUint *out);
+
+/**
+ * Computes the modular inverse of `a` modulo an odd `m`, as `biguint_inverse_mod_odd` does, on the stack.
+ *
+ * @param a The number to invert.
+ * @param m The modulus, which must be odd.
+ * @return  The inverse of `a` modulo `m`, or zero if there is none.
+ */
+u256 u256_inverse_mod(u256 a, u256 m);
+
+/**
+ * Computes the modular inverses of `n` numbers modulo `m` at once, using Montgomery's trick.
+ *
+ * A single inversion of the product of all the elements is run, from which the inverse of each one is recovered with
+ * 3(n-1) modular multiplications, in place of one Extended Euclidean Algorithm per element. Intermediate products
+ * live on the thread's scratch arena.
+ *
+ * Elements that don't have an inverse modulo `m` get `out[i]` set to zero, as `biguint_inverse_mod` does, and don't
+ * disturb the others. For a composite modulus, an element sharing a factor with it makes the whole product
+ * non-invertible, in which case every element is inverted on its own.
+ *
+ * @param in  The numbers to invert.
+ * @param out Where to store the inverses, `out[i]` being the one of `in[i]`. It may be the same array as `in`.
+ * @param n   The number of elements.
+ * @param m   The modulus.
+ * @return    The number of elements that have no inverse modulo `m`.
+ *
+ * @example
+ * ```
+ * BigUint points_z[1000], inverses[1000];
+ * ...
+ * size_t failed = biguint_batch_inverse_mod(points_z, inverses, 1000, p);
+ * ```
+ *
+ * https://en.wikipedia.org/wiki/Modular_multiplicative_inverse#Multiple_inverses
+ */
+size_t biguint_batch_inverse_mod(const BigUint *in, BigUint *out, size_t n, BigUint m);
+
 #endif
@@ -1,20 +1,146 @@
 #include <arithmetics.h>
+#include <assert.h>
+#include <primitive-types/arena.h>
+#include <string.h>
+
+/**
+ * GCD
+ */
+
+// operands of up to this many limbs are handled by the binary gcd, longer ones by Lehmer's until they get that short
+#define GCD_BINARY_LIMBS 2
+
+// leading bits of x taken by each Lehmer step, two below 64 so the cofactors and x + A fit in an int64_t
+#define GCD_LEHMER_BITS 62
+
+static int limbs_len(const uint64_t *x, int n) {
+    while (n > 0 && x[n - 1] == 0)
+        n--;
+    return n;
+}
+
+static int u128_trailing_zeros(__uint128_t x) {
+    uint64_t lo = (uint64_t)x;
+    return lo ? __builtin_ctzll(lo) : 64 + __builtin_ctzll((uint64_t)(x >> 64));
+}
+
+// Stein's binary gcd, shifts and subtractions only
+static __uint128_t gcd_binary(__uint128_t x, __uint128_t y) {
+    if (x == 0)
+        return y;
+    if (y == 0)
+        return x;
+    int shift = u128_trailing_zeros(x | y);
+    x >>= u128_trailing_zeros(x);
+    while (y != 0) {
+        y >>= u128_trailing_zeros(y);
+        if (x > y) {
+            __uint128_t t = x;
+            x = y;
+            y = t;
+        }
+        y -= x;
+    }
+    return x << shift;
+}
+
+// the 64 bits of x starting at bit pos
+static uint64_t limbs_bits_at(const uint64_t *x, int n, int pos) {
+    int limb = pos / 64, shift = pos % 64;
+    uint64_t bits = x[limb] >> shift;
+    if (shift && limb + 1 < n)
+        bits |= x[limb + 1] << (64 - shift);
+    return bits;
+}
+
+// out = a * x + b * y, known to be non negative, with a and b of opposite signs
+static void limbs_lin_comb(uint64_t *out, const uint64_t *x, int64_t a, const uint64_t *y, int64_t b, int n) {
+    __int128 carry = 0;
+    for (int i = 0; i < n; i++) {
+        __int128 acc = carry + (__int128)a * (__int128)x[i] + (__int128)b * (__int128)y[i];
+        out[i] = (uint64_t)acc;
+        carry = acc >> 64;
+    }
+}
 
 void biguint_gcd(BigUint a, BigUint b, BigUint *out) {
-    BigUint rem = biguint_new_heap(a.size);
-    BigUint x = biguint_new_heap(a.size);
-    BigUint y = biguint_new_heap(b.size);
+    int n = a.size > b.size ? a.size : b.size;
+    if (n <= GCD_BINARY_LIMBS) {
+        __uint128_t x = a.limbs[0] | (a.size > 1 ? (__uint128_t)a.limbs[1] << 64 : 0);
+        __uint128_t y = b.limbs[0] | (b.size > 1 ? (__uint128_t)b.limbs[1] << 64 : 0);
+        __uint128_t g = gcd_binary(x, y);
+        uint64_t limbs[2] = {(uint64_t)g, (uint64_t)(g >> 64)};
+        biguint_cpy(out, biguint_new_from_limbs(2, limbs));
+        return;
+    }
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint x = biguint_arena_new(arena, n);
+    BigUint y = biguint_arena_new(arena, n);
+    BigUint tx = biguint_arena_new(arena, n);
+    BigUint ty = biguint_arena_new(arena, n);
     biguint_cpy(&x, a);
     biguint_cpy(&y, b);
+    if (biguint_cmp(x, y) < 0) {
+        BigUint t = x;
+        x = y;
+        y = t;
+    }
+
+    // Lehmer: run Euclid on the leading bits of x and y, as long as the quotients are sure to match the ones of the
+    // full numbers, then apply all those steps at once through the cofactor matrix [A B; C D]
+    int yn;
+    while ((yn = limbs_len(y.limbs, n)) > GCD_BINARY_LIMBS) {
+        int xn = limbs_len(x.limbs, n);
+        int pos = (xn - 1) * 64 + (64 - u64_leading_zeros(x.limbs[xn - 1])) - GCD_LEHMER_BITS;
+        int64_t xh = (int64_t)(limbs_bits_at(x.limbs, n, pos) & ((1ULL << GCD_LEHMER_BITS) - 1));
+        int64_t yh = (int64_t)(limbs_bits_at(y.limbs, n, pos) & ((1ULL << GCD_LEHMER_BITS) - 1));
+        int64_t A = 1, B = 0, C = 0, D = 1;
+        while (yh + C != 0 && yh + D != 0) {
+            int64_t q = (xh + A) / (yh + C);
+            if (q != (xh + B) / (yh + D))
+                break;
+            int64_t t = A - q * C;
+            A = C;
+            C = t;
+            t = B - q * D;
+            B = D;
+            D = t;
+            t = xh - q * yh;
+            xh = yh;
+            yh = t;
+        }
 
-    while (!biguint_is_zero(y)) {
-        biguint_mod(x, y, &rem);
-        biguint_cpy(&x, y);
-        biguint_cpy(&y, rem);
+        if (B == 0) {
+            // not a single quotient could be trusted, a full division step
+            biguint_mod(x, y, &x);
+            BigUint t = x;
+            x = y;
+            y = t;
+        } else {
+            limbs_lin_comb(tx.limbs, x.limbs, A, y.limbs, B, n);
+            limbs_lin_comb(ty.limbs, x.limbs, C, y.limbs, D, n);
+            BigUint t = x;
+            x = tx;
+            tx = t;
+            t = y;
+            y = ty;
+            ty = t;
+        }
     }
 
-    biguint_cpy(out, x);
-    biguint_free(&rem, &x, &y);
+    if (yn == 0) {
+        biguint_cpy(out, x);
+    } else {
+        // y fits the binary gcd, x does too after a division step
+        biguint_mod(x, y, &x);
+        __uint128_t g =
+            gcd_binary(x.limbs[0] | (__uint128_t)x.limbs[1] << 64, y.limbs[0] | (__uint128_t)y.limbs[1] << 64);
+        uint64_t limbs[2] = {(uint64_t)g, (uint64_t)(g >> 64)};
+        biguint_cpy(out, biguint_new_from_limbs(2, limbs));
+    }
+    biguint_arena_reset(arena, mark);
 }
 
 void biguint_lcm(BigUint a, BigUint b, BigUint *out) {
@@ -22,112 +148,388 @@ void biguint_lcm(BigUint a, BigUint b, BigUint *out) {
         biguint_zero(out);
         return;
     }
-    BigUint x = biguint_new_heap(a.size);
-    BigUint y = biguint_new_heap(b.size);
-    biguint_cpy(&x, a);
-    biguint_cpy(&y, b);
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint gcd = biguint_arena_new(arena, a.size < b.size ? a.size : b.size);
+    BigUint quot = biguint_arena_new(arena, a.size);
+    biguint_gcd(a, b, &gcd);
 
-    BigUint gcd = biguint_new_heap(out->size);
-    biguint_gcd(x, y, &gcd);
-    biguint_mul(x, y, out);
-    biguint_div(*out, gcd, out);
+    // a / gcd * b, dividing first keeps the division as short as the smaller operand
+    biguint_div(a, gcd, &quot);
+    biguint_mul(quot, b, out);
 
-    biguint_free(&gcd, &x, &y);
+    biguint_arena_reset(arena, mark);
 }
 
-// verifies if the bezout identity in its modular form (at = gcd(a,b) (mod b)) holds
-// given: a, b, t, gcd(a,b)
-// https://en.wikipedia.org/wiki/Extended_Euclidean_algorithm#Modular_integers
-int biguint_bezout_identity_mod_holds(BigUint a, BigUint t, BigUint m, BigUint gcd) {
-    BigUint at = biguint_new_heap(a.size);
-    biguint_mul(a, t, &at);
-    biguint_mod(at, m, &at);
-    if (biguint_cmp(at, gcd) != 0) {
-        return 0;
-    }
-    return 1;
-};
-
-void biguint_extended_euclidean_algorithm(BigUint a, BigUint b, ExtendedEuclideanAlgorithm *out) {
-    BigUint rp = biguint_new_heap(a.size); // r_0
+void biguint_extended_gcd(BigUint a, BigUint b, BigUint *gcd, BigInt *s, BigInt *t) {
+    int n = a.size > b.size ? a.size : b.size;
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint rp = biguint_arena_new(arena, n); // r_{i-1}
+    BigUint ri = biguint_arena_new(arena, n); // r_i
+    BigUint rem = biguint_arena_new(arena, n);
     biguint_cpy(&rp, a);
-    BigUint ri = biguint_new_heap(a.size); // r_1
     biguint_cpy(&ri, b);
-    BigUint sp = biguint_new_heap(a.size); // s_0
-    biguint_one(&sp);
-    BigUint si = biguint_new_heap(a.size); // s_1
-    biguint_zero(&si);
-    BigUint tp = biguint_new_heap(a.size); // t_0
-    biguint_zero(&tp);
-    BigUint ti = biguint_new_heap(a.size); // t_1
-    biguint_one(&ti);
-
-    BigUint zero = biguint_new_heap(a.size);
-    biguint_zero(&zero);
-
-    BigUint quot = biguint_new_heap(a.size);
-    BigUint r = biguint_new_heap(a.size);
-    BigUint qr = biguint_new_heap(a.size);
-    BigUint s = biguint_new_heap(a.size);
-    BigUint qs = biguint_new_heap(a.size);
-    BigUint t = biguint_new_heap(a.size);
-    BigUint qt = biguint_new_heap(a.size);
+    BigInt quot = {.mag = biguint_arena_new(arena, n), .sign = 1};
+    BigInt prod = {.mag = biguint_arena_new(arena, n), .sign = 1};
+    BigInt sp = {.mag = biguint_arena_new(arena, n), .sign = 1}; // s_{i-1}
+    BigInt si = {.mag = biguint_arena_new(arena, n), .sign = 1}; // s_i
+    BigInt tp = {.mag = biguint_arena_new(arena, n), .sign = 1}; // t_{i-1}
+    BigInt ti = {.mag = biguint_arena_new(arena, n), .sign = 1}; // t_i
+    biguint_one(&sp.mag);
+    biguint_one(&ti.mag);
 
+    // the cofactors are bounded by b / gcd and a / gcd, so n limbs hold every intermediate value
     while (!biguint_is_zero(ri)) {
-        biguint_div(rp, ri, &quot);
+        biguint_divmod(rp, ri, &quot.mag, &rem);
+        BigUint r = rp;
+        rp = ri;
+        ri = rem;
+        rem = r;
 
-        // r = r_{i-1} - q_i * r_i
-        biguint_mul(ri, quot, &qr);
-        biguint_sub(rp, qr, &r);
+        // s_{i+1} = s_{i-1} - q_i * s_i, the previous s_{i-1} buffer is reused for it
+        bigint_mul(quot, si, &prod);
+        bigint_sub(sp, prod, &sp);
+        BigInt x = sp;
+        sp = si;
+        si = x;
 
-        // s = s_{i-1} - q_i * s_i
-        biguint_mul(si, quot, &qs);
-        biguint_sub(sp, qs, &s);
+        if (t) {
+            bigint_mul(quot, ti, &prod);
+            bigint_sub(tp, prod, &tp);
+            x = tp;
+            tp = ti;
+            ti = x;
+        }
+    }
 
-        // t = t_{i-1} - q_i * t_i
-        biguint_mul(ti, quot, &qt);
-        biguint_sub(tp, qt, &t);
+    biguint_cpy(gcd, rp);
+    bigint_cpy(s, sp);
+    if (t)
+        bigint_cpy(t, tp);
+    biguint_arena_reset(arena, mark);
+}
 
-        // update values for next iteration
-        biguint_cpy(&rp, ri);
-        biguint_cpy(&sp, si);
-        biguint_cpy(&tp, ti);
-        biguint_cpy(&ri, r);
-        biguint_cpy(&si, s);
-        biguint_cpy(&ti, t);
+// negative cofactors are stored wrapped around, as 2^(64 * size) - |x|
+static void store_wrapped(BigInt x, BigUint *out, int *sign) {
+    *sign = x.sign;
+    if (x.sign < 0) {
+        biguint_zero(out);
+        biguint_sub(*out, x.mag, out);
+    } else {
+        biguint_cpy(out, x.mag);
     }
+}
+
+void biguint_extended_euclidean_algorithm(BigUint a, BigUint b, ExtendedEuclideanAlgorithm *out) {
+    int n = a.size > b.size ? a.size : b.size;
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigInt s = {.mag = biguint_arena_new(arena, n), .sign = 1};
+    BigInt t = {.mag = biguint_arena_new(arena, n), .sign = 1};
+    biguint_extended_gcd(a, b, &out->rk, &s, &t);
+    store_wrapped(s, &out->sk, &out->sk_sign);
+    store_wrapped(t, &out->tk, &out->tk_sign);
+    biguint_arena_reset(arena, mark);
+}
+
+/**
+ * Safegcd inversion
+ */
+
+// divsteps run per batch, the most whose transition matrix entries fit an int64_t
+#define SAFEGCD_BATCH 62
+#define SAFEGCD_MASK ((1ULL << 62) - 1)
 
-    // to calculate the sign of s,t we validate the modular definition of the bezout identity
-    // if it doesn't hold then it means it is negative (its respective modular value would be t+n or s+n)
-    out->sk_sign = 1;
-    out->tk_sign = 1;
-    if (!biguint_bezout_identity_mod_holds(a, sp, b, rp))
-        out->sk_sign = -1;
-    if (!biguint_bezout_identity_mod_holds(b, tp, a, rp))
-        out->tk_sign = -1;
+// numbers are held in signed 62 bit limbs, all in [0, 2^62) but the top one, which carries the sign. Besides the
+// modulus, values between -2m and m fit
+#define safegcd_len(N) ((N) * 64 / 62 + 1)
 
-    biguint_cpy(&out->rk, rp);
-    biguint_cpy(&out->sk, sp);
-    biguint_cpy(&out->tk, tp);
-    biguint_free(&rp, &ri, &sp, &si, &tp, &ti, &quot, &r, &qr, &s, &qs, &t, &qt);
+// the bound of Bernstein-Yang's theorem 11.2 on the divsteps needed for d bits numbers
+#define safegcd_batches(N) (((49 * (N) * 64 + 80) / 17 + SAFEGCD_BATCH - 1) / SAFEGCD_BATCH)
+
+// scratch needed by safegcd_inverse for an n limbs modulus
+#define safegcd_ws_size(N) (safegcd_len(N) * 5)
+
+// transition matrix of a batch of divsteps, scaled by 2^62: 2^62 * [f'; g'] = [u v; q r] * [f; g]
+typedef struct {
+    int64_t u, v, q, r;
+} SafegcdMatrix;
+
+// runs a batch of divsteps on the low bits of f and g, branch free, returning the new delta
+static int64_t safegcd_divsteps(int64_t delta, uint64_t f, uint64_t g, SafegcdMatrix *t) {
+    uint64_t u = 1, v = 0, q = 0, r = 1;
+    for (int i = 0; i < SAFEGCD_BATCH; i++) {
+        // delta > 0 and g odd: (delta, f, g) = (-delta, g, -f), which the step below turns into
+        // (1 - delta, g, (g - f) / 2)
+        uint64_t swap = -(uint64_t)(delta > 0) & -(g & 1);
+        uint64_t x = (f ^ g) & swap;
+        f ^= x;
+        g = ((g ^ x) ^ swap) - swap;
+        x = (u ^ q) & swap;
+        u ^= x;
+        q = ((q ^ x) ^ swap) - swap;
+        x = (v ^ r) & swap;
+        v ^= x;
+        r = ((r ^ x) ^ swap) - swap;
+        delta = (delta ^ (int64_t)swap) - (int64_t)swap;
+
+        // (delta, f, g) = (1 + delta, f, (g + (g mod 2) f) / 2)
+        uint64_t odd = -(g & 1);
+        g = (g + (f & odd)) >> 1;
+        q += u & odd;
+        r += v & odd;
+        u <<= 1;
+        v <<= 1;
+        delta++;
+    }
+    t->u = (int64_t)u;
+    t->v = (int64_t)v;
+    t->q = (int64_t)q;
+    t->r = (int64_t)r;
+    return delta;
+}
+
+// [f; g] = [u v; q r] * [f; g] / 2^62, exact
+static void safegcd_update_fg(int64_t *f, int64_t *g, int len, const SafegcdMatrix *t) {
+    __int128 cf = (__int128)t->u * f[0] + (__int128)t->v * g[0];
+    __int128 cg = (__int128)t->q * f[0] + (__int128)t->r * g[0];
+    cf >>= 62;
+    cg >>= 62;
+    for (int i = 1; i < len; i++) {
+        cf += (__int128)t->u * f[i] + (__int128)t->v * g[i];
+        cg += (__int128)t->q * f[i] + (__int128)t->r * g[i];
+        f[i - 1] = (int64_t)((uint64_t)cf & SAFEGCD_MASK);
+        g[i - 1] = (int64_t)((uint64_t)cg & SAFEGCD_MASK);
+        cf >>= 62;
+        cg >>= 62;
+    }
+    f[len - 1] = (int64_t)cf;
+    g[len - 1] = (int64_t)cg;
+}
+
+// [d; e] = [u v; q r] * [d; e] / 2^62 mod m, adding the multiples of m that make the division exact and keep both in
+// (-2m, m). m_inv is the inverse of m modulo 2^62
+static void safegcd_update_de(int64_t *d, int64_t *e, const int64_t *m, uint64_t m_inv, int len,
+                              const SafegcdMatrix *t) {
+    // a negative input takes an extra m * (u or v), bringing the output back above -2m
+    int64_t sd = d[len - 1] >> 63, se = e[len - 1] >> 63;
+    int64_t md = (t->u & sd) + (t->v & se);
+    int64_t me = (t->q & sd) + (t->r & se);
+    __int128 cd = (__int128)t->u * d[0] + (__int128)t->v * e[0];
+    __int128 ce = (__int128)t->q * d[0] + (__int128)t->r * e[0];
+    md -= (int64_t)((m_inv * (uint64_t)cd + (uint64_t)md) & SAFEGCD_MASK);
+    me -= (int64_t)((m_inv * (uint64_t)ce + (uint64_t)me) & SAFEGCD_MASK);
+    cd += (__int128)m[0] * md;
+    ce += (__int128)m[0] * me;
+    cd >>= 62;
+    ce >>= 62;
+    for (int i = 1; i < len; i++) {
+        cd += (__int128)t->u * d[i] + (__int128)t->v * e[i] + (__int128)m[i] * md;
+        ce += (__int128)t->q * d[i] + (__int128)t->r * e[i] + (__int128)m[i] * me;
+        d[i - 1] = (int64_t)((uint64_t)cd & SAFEGCD_MASK);
+        e[i - 1] = (int64_t)((uint64_t)ce & SAFEGCD_MASK);
+        cd >>= 62;
+        ce >>= 62;
+    }
+    d[len - 1] = (int64_t)cd;
+    e[len - 1] = (int64_t)ce;
+}
+
+// x = x + (m & mask), or x = (x ^ mask) - mask with m NULL, carrying so all limbs but the top one are in [0, 2^62)
+static void safegcd_cond_add_neg(int64_t *x, const int64_t *m, int64_t mask, int len) {
+    int64_t carry = 0;
+    for (int i = 0; i < len; i++) {
+        int64_t limb = carry + (m ? x[i] + (m[i] & mask) : (x[i] ^ mask) - mask);
+        if (i < len - 1) {
+            x[i] = (int64_t)((uint64_t)limb & SAFEGCD_MASK);
+            carry = limb >> 62;
+        } else {
+            x[i] = limb;
+        }
+    }
+}
+
+static void safegcd_from_limbs(const uint64_t *x, int n, int64_t *out, int len) {
+    for (int i = 0; i < len; i++) {
+        int pos = i * 62, limb = pos / 64, shift = pos % 64;
+        uint64_t bits = limb < n ? x[limb] >> shift : 0;
+        if (shift > 2 && limb + 1 < n)
+            bits |= x[limb + 1] << (64 - shift);
+        out[i] = (int64_t)(bits & SAFEGCD_MASK);
+    }
+}
+
+static void safegcd_to_limbs(const int64_t *x, int len, uint64_t *out, int n) {
+    __uint128_t acc = 0;
+    int bits = 0, j = 0;
+    for (int i = 0; i < len && j < n; i++) {
+        acc |= (__uint128_t)(uint64_t)x[i] << bits;
+        bits += 62;
+        if (bits >= 64) {
+            out[j++] = (uint64_t)acc;
+            acc >>= 64;
+            bits -= 64;
+        }
+    }
+    for (; j < n; j++) {
+        out[j] = (uint64_t)acc;
+        acc = 0;
+    }
+}
+
+// out = a^-1 mod m, for an odd m of n limbs and a < m, taking the same steps whatever their values. Returns whether
+// the inverse exists, out being zero otherwise. ws has safegcd_ws_size(n) limbs
+static int safegcd_inverse(const uint64_t *a, const uint64_t *m, int n, uint64_t *out, int64_t *ws) {
+    int len = safegcd_len(n);
+    int64_t *f = ws, *g = ws + len, *d = ws + len * 2, *e = ws + len * 3, *ms = ws + len * 4;
+    safegcd_from_limbs(m, n, ms, len);
+    safegcd_from_limbs(m, n, f, len);
+    safegcd_from_limbs(a, n, g, len);
+    for (int i = 0; i < len; i++)
+        d[i] = e[i] = 0;
+    e[0] = 1;
+
+    // Newton's iteration doubles the correct low bits of the inverse, m being its own inverse modulo 8
+    uint64_t m_inv = m[0];
+    for (int i = 0; i < 5; i++)
+        m_inv *= 2 - m[0] * m_inv;
+
+    int64_t delta = 1;
+    SafegcdMatrix t;
+    for (int i = safegcd_batches(n); i > 0; i--) {
+        delta = safegcd_divsteps(delta, (uint64_t)f[0], (uint64_t)g[0], &t);
+        safegcd_update_de(d, e, ms, m_inv, len, &t);
+        safegcd_update_fg(f, g, len, &t);
+    }
+
+    // g is now zero and f = +-gcd(a, m), d = f / a mod m, in (-2m, m)
+    int64_t f_sign = f[len - 1] >> 63;
+    safegcd_cond_add_neg(d, ms, d[len - 1] >> 63, len);
+    safegcd_cond_add_neg(d, NULL, f_sign, len);
+    safegcd_cond_add_neg(d, ms, d[len - 1] >> 63, len);
+    safegcd_cond_add_neg(f, NULL, f_sign, len);
+
+    uint64_t not_one = (uint64_t)f[0] ^ 1;
+    for (int i = 1; i < len; i++)
+        not_one |= (uint64_t)f[i];
+    int64_t invertible = -(int64_t)(not_one == 0);
+    for (int i = 0; i < len; i++)
+        d[i] &= invertible;
+    safegcd_to_limbs(d, len, out, n);
+    return invertible != 0;
+}
+
+void biguint_inverse_mod_odd(BigUint a, BigUint m, BigUint *out) {
+    assert(m.limbs[0] & 1);
+    int n = m.size;
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint x = biguint_arena_new(arena, n);
+    if (biguint_len(a) > n || biguint_cmp(a, m) >= 0)
+        biguint_mod(a, m, &x);
+    else
+        biguint_cpy(&x, a);
+
+    BigUint inv = biguint_arena_new(arena, n);
+    int64_t *ws = (int64_t *)biguint_arena_alloc(arena, safegcd_ws_size(n));
+    safegcd_inverse(x.limbs, m.limbs, n, inv.limbs, ws);
+    biguint_cpy(out, inv);
+    biguint_arena_reset(arena, mark);
+}
+
+u256 u256_inverse_mod(u256 a, u256 m) {
+    assert(m.limbs[0] & 1);
+    if (u256_cmp(a, m) >= 0)
+        a = u256_mod(a, m);
+    u256 out;
+    int64_t ws[safegcd_ws_size(4)];
+    safegcd_inverse(a.limbs, m.limbs, 4, out.limbs, ws);
+    return out;
 }
 
 void biguint_inverse_mod(BigUint a, BigUint n, BigUint *out) {
-    ExtendedEuclideanAlgorithm alg = extended_euclidean_algorithm_new_heap(out->size);
-    biguint_extended_euclidean_algorithm(a, n, &alg);
+    if (n.limbs[0] & 1) {
+        biguint_inverse_mod_odd(a, n, out);
+        return;
+    }
 
-    BigUint one = biguint_new_heap(out->size);
-    biguint_one(&one);
+    int size = a.size > n.size ? a.size : n.size;
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint gcd = biguint_arena_new(arena, size);
+    BigInt s = {.mag = biguint_arena_new(arena, size), .sign = 1};
+    biguint_extended_gcd(a, n, &gcd, &s, NULL);
 
-    if (biguint_cmp(alg.rk, one) > 0) {
+    if (biguint_len(gcd) != 1 || gcd.limbs[0] != 1)
         biguint_zero(out);
-    } else {
-        if (alg.sk_sign == -1) {
-            biguint_add(alg.sk, n, &alg.sk);
+    else
+        bigint_mod(s, n, out);
+
+    biguint_arena_reset(arena, mark);
+}
+
+#define batch_is_skipped(SKIPPED, I) (((SKIPPED)[(I) / 64] >> ((I) % 64)) & 1)
+
+size_t biguint_batch_inverse_mod(const BigUint *in, BigUint *out, size_t n, BigUint m) {
+    if (n == 0)
+        return 0;
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    int size = m.size;
+    uint64_t *ws = biguint_arena_alloc(arena, biguint_mul_mod_ws_size(size));
+    uint64_t *skipped = biguint_arena_alloc(arena, (n + 63) / 64);
+    memset(skipped, 0, (n + 63) / 64 * sizeof(uint64_t));
+
+    // prefix i holds the product mod m of the elements before i, leaving out the ones that are multiples of m
+    uint64_t *prefix = biguint_arena_alloc(arena, (n + 1) * size);
+    BigUint acc = biguint_new_from_limbs(size, prefix);
+    biguint_one(&acc);
+    for (size_t i = 0; i < n; i++) {
+        BigUint next = biguint_new_from_limbs(size, prefix + (i + 1) * size);
+        biguint_mul_mod_ws(acc, in[i], m, &next, ws);
+        if (biguint_is_zero(next)) {
+            skipped[i / 64] |= 1ULL << (i % 64);
+            biguint_cpy(&next, acc);
+        }
+        acc = next;
+    }
+
+    size_t failed = 0;
+    BigUint inv = biguint_arena_new(arena, size);
+    BigUint next_inv = biguint_arena_new(arena, size);
+    biguint_inverse_mod(acc, m, &inv);
+
+    if (biguint_is_zero(inv)) {
+        // some element shares a factor with a composite modulus, which the product can't tell apart, so invert them
+        // one by one
+        BigUint one = biguint_arena_new(arena, 1);
+        biguint_one(&one);
+        for (size_t i = 0; i < n; i++) {
+            biguint_mul_mod_ws(in[i], one, m, &next_inv, ws);
+            biguint_inverse_mod(next_inv, m, &inv);
+            biguint_cpy(&out[i], inv);
+            failed += biguint_is_zero(inv);
+        }
+        biguint_arena_reset(arena, mark);
+        return failed;
+    }
+
+    // inv is the inverse of the product of the elements up to i, so inv * prefix_i is the inverse of element i and
+    // inv * element_i the inverse of the product up to i - 1
+    for (size_t i = n; i-- > 0;) {
+        if (batch_is_skipped(skipped, i)) {
+            biguint_zero(&out[i]);
+            failed++;
+            continue;
         }
-        biguint_cpy(out, alg.sk);
+        biguint_mul_mod_ws(inv, in[i], m, &next_inv, ws);
+        biguint_mul_mod_ws(inv, biguint_new_from_limbs(size, prefix + i * size), m, &out[i], ws);
+        BigUint tmp = inv;
+        inv = next_inv;
+        next_inv = tmp;
     }
 
-    biguint_free(&one);
-    extended_euclidean_algorithm_free(alg);
+    biguint_arena_reset(arena, mark);
+    return failed;
 }
@@ -1,5 +1,6 @@
 #include <math/random.h>
 #include <primes.h>
+#include <primitive-types/arena.h>
 
 int biguint_is_prime_solovay_strassen(BigUint p);
 int jacobi(BigUint a, BigUint n);
@@ -16,15 +17,17 @@ void biguint_random_prime(BigUint *a) {
 // Verifies if a number is prime by dividing it by the first 1000 primes
 // If it passes the initial test, then we run a more strong and probable primality test
 int biguint_is_prime(BigUint a) {
-    BigUint p = biguint_new_heap(a.size);
-    BigUint rem = biguint_new_heap(a.size);
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint p = biguint_arena_new(arena, a.size);
+    BigUint rem = biguint_arena_new(arena, a.size);
 
     for (int i = 0; i < PRIMES_LENGTH; i++) {
         biguint_from_u64(PRIMES[i], &p);
 
         // if a <= p and we are at this point, a is 100% prime
         if (biguint_cmp(a, p) <= 0) {
-            biguint_free(&p, &rem);
+            biguint_arena_reset(arena, mark);
             return 1;
         }
 
@@ -32,12 +35,12 @@ int biguint_is_prime(BigUint a) {
 
         // found a factor
         if (biguint_is_zero(rem)) {
-            biguint_free(&p, &rem);
+            biguint_arena_reset(arena, mark);
             return 0;
         }
     }
 
-    biguint_free(&p, &rem);
+    biguint_arena_reset(arena, mark);
     return biguint_is_prime_solovay_strassen(a);
 }
 
@@ -55,20 +58,22 @@ int biguint_is_prime(BigUint a) {
 //    - https://en.wikipedia.org/wiki/Solovay%E2%80%93Strassen_primality_test
 //    - https://web.archive.org/web/20230127011251/http://people.csail.mit.edu/rivest/Rsapaper.pdf (page 9)
 int biguint_is_prime_solovay_strassen(BigUint p) {
-    BigUint one = biguint_new_heap(p.size);
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint one = biguint_arena_new(arena, p.size);
     biguint_one(&one);
-    BigUint two = biguint_new_heap(p.size);
+    BigUint two = biguint_arena_new(arena, p.size);
     biguint_from_u64(2, &two);
 
-    BigUint p_minus_one = biguint_new_heap(p.size);
+    BigUint p_minus_one = biguint_arena_new(arena, p.size);
     biguint_cpy(&p_minus_one, p);
     biguint_sub(p, one, &p_minus_one);
 
-    BigUint exponent = biguint_new_heap(p.size);
+    BigUint exponent = biguint_arena_new(arena, p.size);
     biguint_div(p_minus_one, two, &exponent);
 
-    BigUint a = biguint_new_heap(p.size);
-    BigUint rem = biguint_new_heap(p.size);
+    BigUint a = biguint_arena_new(arena, p.size);
+    BigUint rem = biguint_arena_new(arena, p.size);
     int p_bits = biguint_bits(p);
     int is_prime = 1;
 
@@ -101,7 +106,7 @@ int biguint_is_prime_solovay_strassen(BigUint p) {
         break;
     }
 
-    biguint_free(&one, &two, &exponent, &p_minus_one, &a, &rem);
+    biguint_arena_reset(arena, mark);
 
     return is_prime;
 }
@@ -132,25 +137,27 @@ int biguint_is_prime_solovay_strassen(BigUint p) {
  * https://en.wikipedia.org/wiki/Quadratic_residue
  */
 int jacobi(BigUint a, BigUint n) {
-    BigUint rem = biguint_new_heap(a.size);
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint rem = biguint_arena_new(arena, a.size);
     // a mod (n)
     biguint_mod(a, n, &rem);
     if (biguint_is_zero(rem)) {
-        biguint_free(&rem);
+        biguint_arena_reset(arena, mark);
         return 0;
     }
 
-    BigUint num = biguint_new_heap(a.size);
+    BigUint num = biguint_arena_new(arena, a.size);
     biguint_one(&num);
 
     if (biguint_cmp(a, num) == 0) {
-        biguint_free(&num);
+        biguint_arena_reset(arena, mark);
         return 1;
     }
 
-    BigUint exponent = biguint_new_heap(a.size);
-    BigUint exponent_two = biguint_new_heap(a.size);
-    BigUint next = biguint_new_heap(a.size);
+    BigUint exponent = biguint_arena_new(arena, a.size);
+    BigUint exponent_two = biguint_arena_new(arena, a.size);
+    BigUint next = biguint_arena_new(arena, a.size);
 
     int result;
 
@@ -160,8 +167,7 @@ int jacobi(BigUint a, BigUint n) {
         biguint_pow(exponent, num, &exponent);
         biguint_from_u64(1, &num);
         biguint_sub(exponent, num, &exponent);
-        biguint_from_u64(8, &num);
-        biguint_div(exponent, num, &exponent);
+        biguint_shr(exponent, 3, &exponent);
 
         // (-1)^n = { - 1 if n is even, - -1 if n is odd }
         int calc;
@@ -170,8 +176,7 @@ int jacobi(BigUint a, BigUint n) {
         else
             calc = -1;
 
-        biguint_from_u64(2, &num);
-        biguint_div(a, num, &next);
+        biguint_shr(a, 1, &next);
 
         result = calc * jacobi(next, n);
     } else {
@@ -182,8 +187,7 @@ int jacobi(BigUint a, BigUint n) {
         biguint_sub(exponent_two, num, &exponent_two);
 
         biguint_mul(exponent, exponent_two, &exponent);
-        biguint_from_u64(4, &num);
-        biguint_div(exponent, num, &exponent);
+        biguint_shr(exponent, 2, &exponent);
 
         // (-1)^n = { - 1 if n is even, - -1 if n is odd }
         int calc;
@@ -197,7 +201,7 @@ int jacobi(BigUint a, BigUint n) {
         result = calc * jacobi(next, a);
     }
 
-    biguint_free(&exponent, &exponent_two, &next, &num);
+    biguint_arena_reset(arena, mark);
 
     return result;
 }
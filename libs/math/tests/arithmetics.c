@@ -24,6 +24,20 @@ void test_biguint_gcd() {
     test_biguint_gcd_inner(4, "10000000000000000000", "5000000000000000000", "5000000000000000000");
     test_biguint_gcd_inner(4, "999999999989", "888888888887", "1");
     test_biguint_gcd_inner(4, "987654321012345678901234567890", "12345678901234567890", "90");
+    test_biguint_gcd_inner(2, "3245160776272335813515457677885435", "762476522600357110419465281459",
+                           "2305843009213693951");
+    // a 300 bits common factor, left by Lehmer steps
+    test_biguint_gcd_inner(16,
+                           "6360222874206910339761852196663313740896986289093653194577385481137933368084394555570295"
+                           "4198558449336701068963385495748297030283736545721160060871643304574927961619835600217245"
+                           "7372880060224452691690876372547366939262456362406950231610802491983982736680620087103435"
+                           "918870216514123754370522886677223480",
+                           "2760563539637477310042685117795155135565458102219980425228467602306978408780809264731399"
+                           "1562642182430788083511811742473268263405439262181058435649499716319466671314339101714575"
+                           "4821019390298426416696350015138207921995720301700507468047295064591402805639706532691152"
+                           "731476659706002846285",
+                           "1917359525915034487273676191479476645871853370824685619367355099249397254730355842245397"
+                           "05");
 }
 
 void test_biguint_lcm_inner(int size, char *a, char *b, char *expected) {
@@ -48,6 +62,21 @@ void test_biguint_lcm() {
     test_biguint_lcm_inner(4, "12345678901234567890", "1", "12345678901234567890");
     test_biguint_lcm_inner(4, "987654321012345678901234567890", "12345678901234567890",
                            "135480701251502988873986011750021168887500211690");
+    test_biguint_lcm_inner(32,
+                           "6360222874206910339761852196663313740896986289093653194577385481137933368084394555570295"
+                           "4198558449336701068963385495748297030283736545721160060871643304574927961619835600217245"
+                           "7372880060224452691690876372547366939262456362406950231610802491983982736680620087103435"
+                           "918870216514123754370522886677223480",
+                           "2760563539637477310042685117795155135565458102219980425228467602306978408780809264731399"
+                           "1562642182430788083511811742473268263405439262181058435649499716319466671314339101714575"
+                           "4821019390298426416696350015138207921995720301700507468047295064591402805639706532691152"
+                           "731476659706002846285",
+                           "9157280694200869995975752596628187464826280096911605780747447972186249416740656568164117"
+                           "7091230823339048076113437294578928807493123304455700372166493841106176863475809693429999"
+                           "6929670431613206926971352049862057919768092298724058687211083675307772382646957690781892"
+                           "1591501967727819835226686134596983173652720241124116055680781732854232345778940563166905"
+                           "1381880313341291684609720354928098409336463743407087107223753556462669980652193449467202"
+                           "1959414562903853161605134230419424847232511031490391960");
 }
 
 void test_biguint_extended_euclidean_algorithm_inner(int size, char *a, char *b, char *rk, char *sk, char *tk) {
@@ -80,6 +109,38 @@ void test_biguint_extended_euclidean_algorithm() {
         4, "161", "28", "7", "115792089237316195423570985008687907853269984665640564039457584007913129639935", "6");
 }
 
+void test_biguint_extended_gcd() {
+    BigUint a = biguint_new_heap(4);
+    BigUint b = biguint_new_heap(4);
+    BigUint gcd = biguint_new_heap(4);
+    BigInt s = bigint_new_heap(4);
+    BigInt t = bigint_new_heap(4);
+
+    // 161 * -1 + 28 * 6 = 7
+    biguint_from_dec_string("161", &a);
+    biguint_from_dec_string("28", &b);
+    biguint_extended_gcd(a, b, &gcd, &s, &t);
+    assert_that(biguint_len(gcd) == 1 && gcd.limbs[0] == 7);
+    assert_that(s.sign == -1 && biguint_len(s.mag) == 1 && s.mag.limbs[0] == 1);
+    assert_that(t.sign == 1 && biguint_len(t.mag) == 1 && t.mag.limbs[0] == 6);
+
+    // a * s + b * t = gcd, on 2^192 sized operands
+    biguint_from_dec_string("6277101735386680763835789423207666416102355444464034512895", &a);
+    biguint_from_dec_string("3138550867693340381917894711603833208051177722232017256448", &b);
+    biguint_extended_gcd(a, b, &gcd, &s, &t);
+
+    BigInt as = bigint_new_heap(8), bt = bigint_new_heap(8), sum = bigint_new_heap(8);
+    BigInt a_int = {.mag = a, .sign = 1}, b_int = {.mag = b, .sign = 1};
+    bigint_mul(a_int, s, &as);
+    bigint_mul(b_int, t, &bt);
+    bigint_add(as, bt, &sum);
+    assert_that(sum.sign == 1 && biguint_cmp(sum.mag, gcd) == 0);
+    assert_that(s.sign != t.sign);
+
+    biguint_free(&a, &b, &gcd);
+    bigint_free(&s, &t, &as, &bt, &sum);
+}
+
 void test_biguint_inverse_mod_inner(int size, char *a, char *n, char *expected) {
     BigUint x = biguint_new_heap(size);
     BigUint y = biguint_new_heap(size);
@@ -124,12 +185,107 @@ void test_biguint_inverse_mod() {
                                    "0");
 }
 
+void test_biguint_inverse_mod_odd() {
+    // 2^256 - 2^32 - 977, the secp256k1 field prime
+    BigUint p = biguint_new_heap(4);
+    biguint_from_hex("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 64, &p);
+    BigUint a = biguint_new_heap(8);
+    BigUint inverse = biguint_new_heap(4);
+    BigUint product = biguint_new_heap(4);
+
+    // a above the modulus gets reduced first
+    biguint_from_dec_string("1234567890123456789012345678901234567890123456789012345678901234567890123456789012345",
+                            &a);
+    biguint_inverse_mod_odd(a, p, &inverse);
+    biguint_mul_mod(a, inverse, p, &product);
+    assert_that(biguint_len(product) == 1 && product.limbs[0] == 1);
+
+    // 15 and 225 share a factor
+    BigUint m = biguint_new_heap(4);
+    biguint_from_dec_string("225", &m);
+    biguint_from_dec_string("15", &a);
+    biguint_inverse_mod_odd(a, m, &inverse);
+    assert_that(biguint_is_zero(inverse));
+
+    biguint_from_dec_string("7", &a);
+    biguint_inverse_mod_odd(a, m, &inverse);
+    assert_that(biguint_len(inverse) == 1 && inverse.limbs[0] == 193);
+
+    biguint_free(&p, &a, &inverse, &product, &m);
+}
+
+void test_u256_inverse_mod() {
+    // the secp256k1 group order
+    u256 n, a, expected;
+    u256_from_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 64, &n);
+    u256_from_hex("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 64, &a);
+    u256 inverse = u256_inverse_mod(a, n);
+    assert_that(u256_cmp(u256_mul_mod(a, inverse, n), u256_one()) == 0);
+
+    BigUint expected_inverse = biguint_new_heap(4);
+    biguint_inverse_mod_odd(uint_to_biguint(a), uint_to_biguint(n), &expected_inverse);
+    expected = u256_from_biguint(expected_inverse);
+    assert_that(u256_cmp(inverse, expected) == 0);
+
+    assert_that(u256_is_zero(u256_inverse_mod(u256_zero(), n)));
+    biguint_free(&expected_inverse);
+}
+
+void test_biguint_batch_inverse_mod_inner(char *mod, char **values, int count, size_t expected_failed) {
+    BigUint m = biguint_new_heap(4);
+    biguint_from_dec_string(mod, &m);
+    BigUint in[8], out[8];
+    for (int i = 0; i < count; i++) {
+        in[i] = biguint_new_heap(4);
+        out[i] = biguint_new_heap(4);
+        biguint_from_dec_string(values[i], &in[i]);
+    }
+
+    assert_that(biguint_batch_inverse_mod(in, out, count, m) == expected_failed);
+
+    BigUint expected = biguint_new_heap(4);
+    for (int i = 0; i < count; i++) {
+        biguint_inverse_mod(in[i], m, &expected);
+        assert_that(biguint_cmp(out[i], expected) == 0);
+    }
+
+    // in place
+    biguint_batch_inverse_mod(in, in, count, m);
+    for (int i = 0; i < count; i++) {
+        assert_that(biguint_cmp(in[i], out[i]) == 0);
+        biguint_free(&in[i], &out[i]);
+    }
+    biguint_free(&m, &expected);
+}
+
+void test_biguint_batch_inverse_mod() {
+    char *prime_values[] = {"13",
+                            "1234567890123456789012345678901234567890123456789012345678901234",
+                            "0",
+                            "115792089237316195423570985008687907853269984665640564039457584007913129639746",
+                            "115792089237316195423570985008687907853269984665640564039457584007913129639747",
+                            "1",
+                            "57896044618658097711785492504343953926634992332820282019728792003956564819968"};
+    test_biguint_batch_inverse_mod_inner(
+        "115792089237316195423570985008687907853269984665640564039457584007913129639747", prime_values, 7, 2);
+
+    char *composite_values[] = {"13", "14", "3", "27", "0", "9"};
+    test_biguint_batch_inverse_mod_inner("28", composite_values, 6, 2);
+
+    char *single_value[] = {"5"};
+    test_biguint_batch_inverse_mod_inner("28", single_value, 1, 0);
+}
+
 int main() {
     BEGIN_TEST()
     test(test_biguint_gcd);
     test(test_biguint_lcm);
     test(test_biguint_extended_euclidean_algorithm);
+    test(test_biguint_extended_gcd);
     test(test_biguint_inverse_mod);
+    test(test_biguint_inverse_mod_odd);
+    test(test_u256_inverse_mod);
+    test(test_biguint_batch_inverse_mod);
     END_TEST()
 
     return 0;
@@ -1,3 +1,4 @@
+#include <limits.h>
 #include <math/random.h>
 #include <primitive-types/biguint.h>
 #include <utils/benchmark.h>
@@ -54,6 +55,150 @@ void benchmark_pow_mod() {
     biguint_pow_mod(a, b, m, &a);
 }
 
+void benchmark_multi_pow_mod() {
+    BigUint bases[2] = {biguint_new(16), biguint_new(16)};
+    BigUint exponents[2] = {biguint_new(16), biguint_new(16)};
+    BigUint m = biguint_new(16);
+    for (int i = 0; i < 2; i++) {
+        biguint_random(&bases[i]);
+        biguint_random(&exponents[i]);
+    }
+    biguint_random(&m);
+    biguint_multi_pow_mod(bases, exponents, 2, m, &m);
+}
+
+void benchmark_mul_mod_ws() {
+    BigUint a = biguint_new(16);
+    BigUint b = biguint_new(16);
+    BigUint m = biguint_new(16);
+    uint64_t ws[biguint_mul_mod_ws_size(16)];
+    biguint_random(&a);
+    biguint_random(&b);
+    biguint_random(&m);
+    biguint_mul_mod_ws(a, b, m, &a, ws);
+}
+
+void benchmark_to_dec_string() {
+    BigUint a = biguint_new(256);
+    biguint_random(&a);
+    free(biguint_to_dec_string(a));
+}
+
+void benchmark_from_dec_string() {
+    BigUint a = biguint_new(4);
+    biguint_from_dec_string("115792089237316195423570985008687907853269984665640564039457584007908834671663", &a);
+}
+
+void benchmark_mul_sized(BigUint a, BigUint b, BigUint *out) { biguint_mul(a, b, out); }
+
+// multiplies (and squares) the same operands forcing each algorithm at the top level, to see where one starts
+// beating the other and tune the thresholds accordingly
+void benchmark_mul_crossover() {
+    int sizes[] = {16, 24, 32, 48, 64, 96, 128, 192, 256, 512, 1024, 2048, 4096};
+    const char *names[] = {"schoolbook", "karatsuba", "toom3", "ntt"};
+    int karatsuba_threshold = biguint_karatsuba_threshold();
+    int toom3_threshold = biguint_toom3_threshold();
+    int ntt_threshold = biguint_ntt_threshold();
+
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        int n = sizes[i];
+        int iterations = 20000000 / (n * n) + 10;
+        BigUint a = biguint_new_heap(n);
+        BigUint b = biguint_new_heap(n);
+        BigUint out = biguint_new_heap(n * 2);
+        biguint_random(&a);
+        biguint_random(&b);
+
+        for (int algorithm = 0; algorithm < 4; algorithm++) {
+            biguint_set_karatsuba_threshold(algorithm == 0 ? INT_MAX : karatsuba_threshold);
+            biguint_set_toom3_threshold(algorithm == 2 ? n : INT_MAX);
+            biguint_set_ntt_threshold(algorithm == 3 ? n : INT_MAX);
+
+            char name[64];
+            snprintf(name, sizeof(name), "biguint_mul %s %d bits", names[algorithm], n * 64);
+            benchmark(name, benchmark_mul_sized, iterations, a, b, &out);
+            snprintf(name, sizeof(name), "biguint_sqr %s %d bits", names[algorithm], n * 64);
+            benchmark(name, benchmark_mul_sized, iterations, a, a, &out);
+        }
+
+        biguint_free(&a, &b, &out);
+    }
+
+    biguint_set_karatsuba_threshold(karatsuba_threshold);
+    biguint_set_toom3_threshold(toom3_threshold);
+    biguint_set_ntt_threshold(ntt_threshold);
+}
+
+// compares the assembly limb kernels against the portable ones on the limb counts used by the curves and rsa
+void benchmark_asm_kernels() {
+    int sizes[] = {4, 6, 8, 16, 32, 48, 64};
+    int enabled = biguint_asm_kernels();
+
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        int n = sizes[i];
+        int iterations = 20000000 / (n * n) + 10;
+        BigUint a = biguint_new_heap(n);
+        BigUint b = biguint_new_heap(n);
+        BigUint out = biguint_new_heap(n * 2);
+        biguint_random(&a);
+        biguint_random(&b);
+
+        for (int asm_kernels = 0; asm_kernels <= 1; asm_kernels++) {
+            biguint_set_asm_kernels(asm_kernels);
+            const char *kernel = asm_kernels ? "asm" : "portable";
+
+            char name[64];
+            snprintf(name, sizeof(name), "biguint_mul %s %d bits", kernel, n * 64);
+            benchmark(name, benchmark_mul_sized, iterations, a, b, &out);
+            snprintf(name, sizeof(name), "biguint_sqr %s %d bits", kernel, n * 64);
+            benchmark(name, benchmark_mul_sized, iterations, a, a, &out);
+        }
+
+        biguint_free(&a, &b, &out);
+    }
+
+    biguint_set_asm_kernels(enabled);
+}
+
+void benchmark_pow_mod_batch_sized(BigUint *bases, BigUint *exponents, BigUint *moduli, BigUint *outs, int count) {
+    biguint_pow_mod_batch(bases, exponents, moduli, outs, count);
+}
+
+// 16 full sized exponentiations at once, with the IFMA lanes against one biguint_pow_mod after the other
+void benchmark_pow_mod_batch() {
+    int sizes[] = {16, 32};
+    int enabled = biguint_asm_kernels();
+
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        int n = sizes[i];
+        BigUint bases[16], exponents[16], moduli[16], outs[16];
+        for (int j = 0; j < 16; j++) {
+            bases[j] = biguint_new_heap(n);
+            exponents[j] = biguint_new_heap(n);
+            moduli[j] = biguint_new_heap(n);
+            outs[j] = biguint_new_heap(n);
+            biguint_random(&bases[j]);
+            biguint_random(&exponents[j]);
+            biguint_random(&moduli[j]);
+            moduli[j].limbs[0] |= 1;
+        }
+
+        for (int asm_kernels = 0; asm_kernels <= 1; asm_kernels++) {
+            biguint_set_asm_kernels(asm_kernels);
+            char name[64];
+            snprintf(name, sizeof(name), "biguint_pow_mod_batch %s 16 x %d bits", asm_kernels ? "asm" : "portable",
+                     n * 64);
+            benchmark(name, benchmark_pow_mod_batch_sized, 5, bases, exponents, moduli, outs, 16);
+        }
+
+        for (int j = 0; j < 16; j++) {
+            biguint_free(&bases[j], &exponents[j], &moduli[j], &outs[j]);
+        }
+    }
+
+    biguint_set_asm_kernels(enabled);
+}
+
 int main() {
     BEGIN_BENCHMARK();
     benchmark("biguint_add random 1024 bits", benchmark_add, 1000000);
@@ -62,5 +207,12 @@ int main() {
     benchmark("biguint_mul random 1024 bits", benchmark_mul, 1000000);
     benchmark("biguint_pow random 1024 bits", benchmark_pow, 1000);
     benchmark("biguint_pow_mod random 1024 bits", benchmark_pow_mod, 10);
+    benchmark("biguint_multi_pow_mod 2 terms random 1024 bits", benchmark_multi_pow_mod, 10);
+    benchmark("biguint_mul_mod_ws random 1024 bits", benchmark_mul_mod_ws, 100000);
+    benchmark("biguint_to_dec_string random 16384 bits", benchmark_to_dec_string, 1000);
+    benchmark("biguint_from_dec_string 78 digits", benchmark_from_dec_string, 1000000);
+    benchmark_mul_crossover();
+    benchmark_asm_kernels();
+    benchmark_pow_mod_batch();
     END_BENCHMARK();
 }
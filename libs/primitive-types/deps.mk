@@ -1,3 +1,3 @@
-BUILD_DEPS := utils
+BUILD_DEPS := utils pthread
 TESTS_DEPS := utils
 BENCHMARKS_DEPS := utils math
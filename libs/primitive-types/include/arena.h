@@ -0,0 +1,112 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "biguint.h"
+#include <stddef.h>
+
+/**
+ * A block of limbs owned by an arena, blocks are chained so growing an arena never moves what was already handed out.
+ */
+typedef struct BigUintArenaBlock {
+    struct BigUintArenaBlock *prev;
+    struct BigUintArenaBlock *next;
+    size_t capacity;
+    size_t top;
+    uint64_t limbs[];
+} BigUintArenaBlock;
+
+/**
+ * Bump allocator for BigUint temporaries.
+ *
+ * Allocating is just moving a pointer forward, and memory is given back in bulk by resetting the arena to a mark taken
+ * earlier, in a stack like fashion. Blocks are kept after a reset, hence once an arena has grown to the size a
+ * workload needs, it stops touching the heap at all.
+ *
+ * Every thread has a default arena, returned by `biguint_scratch`, which is the one used for the internal temporaries
+ * of the library.
+ *
+ * @example
+ * ```
+ * BigUintArena *arena = biguint_scratch();
+ * BigUintArenaMark mark = biguint_arena_mark(arena);
+ * BigUint tmp = biguint_arena_new(arena, 8);
+ * // ... use tmp
+ * biguint_arena_reset(arena, mark);  // releases tmp and anything allocated after the mark
+ * ```
+ */
+typedef struct {
+    BigUintArenaBlock *current;
+} BigUintArena;
+
+/**
+ * Position of an arena at a given moment, resetting to it releases everything allocated afterwards.
+ */
+typedef struct {
+    BigUintArenaBlock *block;
+    size_t top;
+} BigUintArenaMark;
+
+/**
+ * Initializes an arena whose first block holds `limbs` limbs.
+ *
+ * @param arena Pointer to the arena to initialize.
+ * @param limbs The initial capacity in limbs.
+ */
+void biguint_arena_init(BigUintArena *arena, size_t limbs);
+
+/**
+ * Frees all the blocks of an arena, every BigUint allocated from it becomes invalid. Freeing an arena that was
+ * already freed does nothing.
+ *
+ * @param arena Pointer to the arena to free.
+ */
+void biguint_arena_free(BigUintArena *arena);
+
+/**
+ * Allocates `limbs` uninitialized limbs from the arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param limbs The number of limbs.
+ * @return A pointer to the limbs, valid until the arena is reset to a mark taken before this call.
+ */
+uint64_t *biguint_arena_alloc(BigUintArena *arena, size_t limbs);
+
+/**
+ * Allocates a BigUint of `size` limbs from the arena, all initialized to 0.
+ *
+ * @param arena Pointer to the arena.
+ * @param size The number of limbs.
+ * @return The new BigUint, valid until the arena is reset to a mark taken before this call.
+ */
+BigUint biguint_arena_new(BigUintArena *arena, int size);
+
+/**
+ * Returns the current position of the arena.
+ *
+ * @param arena Pointer to the arena.
+ * @return The mark to later reset the arena to.
+ */
+BigUintArenaMark biguint_arena_mark(BigUintArena *arena);
+
+/**
+ * Releases everything allocated from the arena after `mark` was taken.
+ *
+ * @param arena Pointer to the arena.
+ * @param mark A mark returned by `biguint_arena_mark` on the same arena.
+ */
+void biguint_arena_reset(BigUintArena *arena, BigUintArenaMark mark);
+
+/**
+ * Returns the default arena of the calling thread, it is created on first use.
+ *
+ * @return Pointer to the thread local arena.
+ */
+BigUintArena *biguint_scratch();
+
+/**
+ * Frees the default arena of the calling thread, threads that used the library should call it before exiting to not
+ * leak it. It is created again if used afterwards.
+ */
+void biguint_scratch_free();
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef BIGINT_H
+#define BIGINT_H
+
+#include "biguint.h"
+
+/**
+ * Signed integer in sign-magnitude form, a `BigUint` holding the absolute value plus a sign.
+ *
+ * Zero is always positive. As with `BigUint`, results are truncated to the size of the output, which must be able to
+ * hold the magnitude of the result.
+ */
+typedef struct {
+    BigUint mag; // Absolute value
+    int sign;    // -1 if negative, 1 if positive or zero
+} BigInt;
+
+/**
+ * Allocates a `BigInt` on the heap, initialized to 0.
+ *
+ * @param SIZE The number of limbs (64-bit integers) of the magnitude.
+ *
+ * @note
+ * You must call `bigint_free` to release the memory after use to avoid memory leaks.
+ *
+ * @example
+ * ```
+ * BigInt num = bigint_new_heap(10);
+ * bigint_free(&num);
+ * ```
+ */
+#define bigint_new_heap(SIZE)                                                                                          \
+    (BigInt) { .mag = {.size = (SIZE), .limbs = calloc((SIZE), sizeof(uint64_t))}, .sign = 1 }
+
+/**
+ * Creates a `BigInt` on the stack, initialized to 0.
+ *
+ * @param SIZE The number of limbs (64-bit integers) of the magnitude.
+ */
+#define bigint_new(SIZE)                                                                                               \
+    (BigInt) { .mag = biguint_new(SIZE), .sign = 1 }
+
+/**
+ * Frees the memory allocated for one or more BigInt variables.
+ *
+ * @param ... Variadic arguments of BigInt pointers to be freed.
+ */
+#define bigint_free(...)                                                                                               \
+    BigInt *ANONYMOUS_VARIABLE(args)[] = {__VA_ARGS__};                                                                \
+    for (size_t i = 0; i < sizeof(ANONYMOUS_VARIABLE(args)) / sizeof(ANONYMOUS_VARIABLE(args)[0]); i++)                \
+        biguint_free_limbs(&ANONYMOUS_VARIABLE(args)[i]->mag);
+
+/**
+ * Sets `out` to the non negative value `a`.
+ *
+ * @param a   The value.
+ * @param out Pointer to store the result.
+ */
+void bigint_from_biguint(BigUint a, BigInt *out);
+
+/**
+ * Copies `src` into `dst`.
+ *
+ * @param dst Pointer to the destination.
+ * @param src The value to copy.
+ */
+void bigint_cpy(BigInt *dst, BigInt src);
+
+/**
+ * Checks whether a BigInt is zero.
+ *
+ * @param a The value.
+ * @return 1 if `a` is zero, 0 otherwise.
+ */
+int bigint_is_zero(BigInt a);
+
+/**
+ * Compares two BigInt values.
+ *
+ * @param a The first value.
+ * @param b The second value.
+ * @return -1 if `a < b`, 0 if they are equal and 1 if `a > b`.
+ */
+int bigint_cmp(BigInt a, BigInt b);
+
+/**
+ * Computes `-a` and stores the result in `out`.
+ *
+ * @param a   The value.
+ * @param out Pointer to store the result.
+ */
+void bigint_neg(BigInt a, BigInt *out);
+
+/**
+ * Computes `a + b` and stores the result in `out`, which may be one of the operands.
+ *
+ * @param a   The first operand.
+ * @param b   The second operand.
+ * @param out Pointer to store the result.
+ *
+ * @example
+ * ```
+ * BigInt a = bigint_new(1), b = bigint_new(1), result = bigint_new(1);
+ * a.mag.limbs[0] = 3;
+ * b.mag.limbs[0] = 5;
+ * b.sign = -1;
+ * bigint_add(a, b, &result);  // result is -2
+ * ```
+ */
+void bigint_add(BigInt a, BigInt b, BigInt *out);
+
+/**
+ * Computes `a - b` and stores the result in `out`, which may be one of the operands.
+ *
+ * @param a   The first operand.
+ * @param b   The second operand.
+ * @param out Pointer to store the result.
+ */
+void bigint_sub(BigInt a, BigInt b, BigInt *out);
+
+/**
+ * Computes `a * b` and stores the result in `out`, which may be one of the operands.
+ *
+ * @param a   The first operand.
+ * @param b   The second operand.
+ * @param out Pointer to store the result.
+ */
+void bigint_mul(BigInt a, BigInt b, BigInt *out);
+
+/**
+ * Computes the least non negative residue of `a` modulo `m`, which lies in `[0, m)` whatever the sign of `a`.
+ *
+ * @param a   The value to reduce.
+ * @param m   The modulus, non zero.
+ * @param out Pointer to store the result.
+ *
+ * @example
+ * ```
+ * // -3 mod 11 = 8
+ * bigint_mod(minus_three, eleven, &result);
+ * ```
+ */
+void bigint_mod(BigInt a, BigUint m, BigUint *out);
+
+#endif
@@ -132,8 +132,13 @@ void biguint_from_u64(uint64_t val, BigUint *out);
 /**
  * Initializes a BigUint from a decimal string.
  *
+ * Digits are read 19 at a time, and very long strings are split recursively by powers of 10^19 so that most of the
+ * work runs on the fast multiplications. On failure `out` is set to zero.
+ *
  * @param str The decimal string to convert.
  * @param out Pointer to the BigUint to store the value.
+ * @return 0 on success, -1 when the string is empty, has a character other than a digit or its value does not fit
+ *         into `out`.
  *
  * @example
  * ```
@@ -141,7 +146,28 @@ void biguint_from_u64(uint64_t val, BigUint *out);
  * biguint_from_dec_string("12345", &num);  // Convert the string "12345" into a BigUint
  * ```
  */
-void biguint_from_dec_string(char *str, BigUint *out);
+int biguint_from_dec_string(char *str, BigUint *out);
+
+/**
+ * Initializes a BigUint from the first `len` characters of a decimal string, which does not need a null terminator.
+ *
+ * Meant for values taken straight out of a larger buffer, such as CSV or JSON fields. Strings up to 4864 digits are
+ * parsed directly into `out`, without touching any allocator, longer ones use the thread's scratch arena.
+ * On failure `out` is set to zero.
+ *
+ * @param str The decimal digits to convert.
+ * @param len The number of digits.
+ * @param out Pointer to the BigUint to store the value.
+ * @return 0 on success, -1 when `len` is not positive, a character is not a digit or the value does not fit into
+ *         `out`.
+ *
+ * @example
+ * ```
+ * BigUint num = biguint_new(1);
+ * biguint_from_dec("12345,678", 5, &num);  // num = 12345
+ * ```
+ */
+int biguint_from_dec(const char *str, int len, BigUint *out);
 
 /**
  * Initializes a BigUint from a byte array in big-endian format.
@@ -203,6 +229,112 @@ void biguint_from_bytes_little_endian(uint8_t *bytes, BigUint *out);
  */
 void biguint_get_bytes_little_endian(BigUint value, uint8_t *buffer);
 
+/**
+ * Initializes a BigUint from a big-endian byte array of any length.
+ *
+ * Unlike `biguint_from_bytes_big_endian`, the array does not need to be `out->size * 8` bytes long, so shorter inputs
+ * need no zero padded copy. Leading zero bytes are ignored.
+ *
+ * @param bytes The byte array to convert.
+ * @param len   The number of bytes.
+ * @param out   Pointer to the BigUint to store the value.
+ * @return 0 on success, -1 when the value does not fit into `out`, which is then set to zero.
+ *
+ * @example
+ * ```
+ * uint8_t bytes[3] = {0x01, 0x00, 0x02};
+ * BigUint num = biguint_new(1);
+ * biguint_read_bytes_big_endian(bytes, 3, &num);  // num = 0x010002
+ * ```
+ */
+int biguint_read_bytes_big_endian(const uint8_t *bytes, int len, BigUint *out);
+
+/**
+ * Writes a BigUint as exactly `len` big-endian bytes, padded with leading zeros.
+ *
+ * @param value  The BigUint value.
+ * @param buffer The byte array to store the result, at least `len` bytes long.
+ * @param len    The number of bytes to write.
+ * @return 0 on success, -1 when the value needs more than `len` bytes, in which case nothing is written.
+ *
+ * @example
+ * ```
+ * BigUint num = biguint_new_with_limbs(1, {0x010002});
+ * uint8_t buffer[4];
+ * biguint_write_bytes_big_endian(num, buffer, 4);  // buffer = {0x00, 0x01, 0x00, 0x02}
+ * ```
+ */
+int biguint_write_bytes_big_endian(BigUint value, uint8_t *buffer, int len);
+
+/**
+ * Initializes a BigUint from a little-endian byte array of any length.
+ *
+ * Trailing zero bytes, the most significant ones, are ignored.
+ *
+ * @param bytes The byte array to convert.
+ * @param len   The number of bytes.
+ * @param out   Pointer to the BigUint to store the value.
+ * @return 0 on success, -1 when the value does not fit into `out`, which is then set to zero.
+ */
+int biguint_read_bytes_little_endian(const uint8_t *bytes, int len, BigUint *out);
+
+/**
+ * Writes a BigUint as exactly `len` little-endian bytes, padded with trailing zeros.
+ *
+ * @param value  The BigUint value.
+ * @param buffer The byte array to store the result, at least `len` bytes long.
+ * @param len    The number of bytes to write.
+ * @return 0 on success, -1 when the value needs more than `len` bytes, in which case nothing is written.
+ */
+int biguint_write_bytes_little_endian(BigUint value, uint8_t *buffer, int len);
+
+/**
+ * Initializes a BigUint from the first `len` characters of a hexadecimal string, optionally prefixed by `0x`.
+ *
+ * Digits may be in either case. The string does not need a null terminator and nothing is allocated, 16 digits are
+ * decoded at a time.
+ *
+ * @param str The hexadecimal digits to convert.
+ * @param len The number of characters.
+ * @param out Pointer to the BigUint to store the value.
+ * @return 0 on success, -1 when there are no digits, a character is not a hex digit or the value does not fit into
+ *         `out`, which is then set to zero.
+ *
+ * @example
+ * ```
+ * BigUint num = biguint_new(1);
+ * biguint_from_hex("0xff", 4, &num);  // num = 255
+ * ```
+ */
+int biguint_from_hex(const char *str, int len, BigUint *out);
+
+/**
+ * Returns a buffer size large enough for the hexadecimal representation of a, including the null terminator.
+ *
+ * @param a The BigUint value to be converted.
+ * @return The number of bytes `biguint_write_hex` needs.
+ */
+int biguint_hex_size(BigUint a);
+
+/**
+ * Writes the lowercase hexadecimal representation of a BigUint into a caller provided buffer, null terminated.
+ *
+ * There is no `0x` prefix and no leading zeros, zero itself is written as "0".
+ *
+ * @param a      The BigUint value to convert.
+ * @param buffer The buffer receiving the digits.
+ * @param size   The size of the buffer, `biguint_hex_size(a)` is always enough.
+ * @return The number of digits written, not counting the null terminator, or -1 when the buffer is too small.
+ *
+ * @example
+ * ```
+ * BigUint num = biguint_new_with_limbs(1, {255});
+ * char buffer[3];
+ * biguint_write_hex(num, buffer, sizeof(buffer));  // buffer = "ff"
+ * ```
+ */
+int biguint_write_hex(BigUint a, char *buffer, int size);
+
 /**
  * Converts a BigUint to a decimal string.
  *
@@ -217,6 +349,34 @@ void biguint_get_bytes_little_endian(BigUint value, uint8_t *buffer);
  */
 char *biguint_to_dec_string(BigUint a);
 
+/**
+ * Returns a buffer size large enough for the decimal representation of a, including the null terminator.
+ *
+ * @param a The BigUint value to be converted.
+ * @return The number of bytes `biguint_write_dec` needs at most.
+ */
+int biguint_dec_size(BigUint a);
+
+/**
+ * Writes the decimal representation of a BigUint into a caller provided buffer, null terminated.
+ *
+ * Digits are produced 19 at a time, and large values are first split recursively by powers of 10^19, so the
+ * conversion does not run a long division for every digit. Nothing is allocated on the heap.
+ *
+ * @param a      The BigUint value to convert.
+ * @param buffer The buffer receiving the digits.
+ * @param size   The size of the buffer, `biguint_dec_size(a)` is always enough.
+ * @return The number of digits written, not counting the null terminator, or -1 when the buffer is too small.
+ *
+ * @example
+ * ```
+ * BigUint num = biguint_new_with_limbs(1, {1234});
+ * char buffer[8];
+ * int len = biguint_write_dec(num, buffer, sizeof(buffer));  // buffer = "1234", len = 4
+ * ```
+ */
+int biguint_write_dec(BigUint a, char *buffer, int size);
+
 /**
  * Copies the value of one BigUint to another.
  *
@@ -232,6 +392,24 @@ char *biguint_to_dec_string(BigUint a);
  */
 void biguint_cpy(BigUint *dst, BigUint src);
 
+/**
+ * Returns the number of significant limbs of the BigUint, that is its size without the leading zero limbs.
+ *
+ * Arithmetic works on this length rather than on `size`, so a value stored in a buffer larger than it needs (for
+ * example a double width one meant to hold a product) costs as much as its magnitude.
+ *
+ * @param a The BigUint value.
+ * @return The number of limbs up to the most significant non zero one, 0 when `a` is zero.
+ *
+ * @example
+ * ```
+ * BigUint num = biguint_new(4);
+ * biguint_from_u64(7, &num);
+ * int len = biguint_len(num);  // 1
+ * ```
+ */
+int biguint_len(BigUint a);
+
 /**
  * Returns the number of bits required to represent the BigUint.
  *
@@ -261,7 +439,7 @@ int biguint_bits(BigUint a);
 int biguint_is_zero(BigUint a);
 
 /**
- * Compares two BigUint values.
+ * Compares two BigUint values, which may have different sizes.
  *
  * @param a The first BigUint value.
  * @param b The second BigUint value.
@@ -331,12 +509,12 @@ void biguint_add(BigUint a, BigUint b, BigUint *out);
 void biguint_add_mod(BigUint a, BigUint b, BigUint m, BigUint *out);
 
 /**
- * Checks for overflow when adding two BigUint values.
+ * Checks for overflow when subtracting two BigUint values.
  *
  * @param a The first BigUint operand.
  * @param b The second BigUint operand.
  * @param out Pointer to store the result (optional).
- * @return 1 if overflow occurs, 0 otherwise.
+ * @return 1 if `b > a` or if the difference does not fit in `out`, 0 otherwise.
  *
  * @example
  * ```
@@ -419,6 +597,168 @@ int biguint_overflow_mul(BigUint a, BigUint b, BigUint *out);
  */
 void biguint_mul(BigUint a, BigUint b, BigUint *out);
 
+/**
+ * Squares a BigUint value and stores the result in `out`.
+ *
+ * Faster than `biguint_overflow_mul(a, a, out)`, as each cross product `a_i * a_j` is computed once and doubled.
+ *
+ * @param a The BigUint operand.
+ * @param out Pointer to store the result.
+ * @return 1 if overflow occurs, 0 otherwise.
+ *
+ * @example
+ * ```
+ * BigUint a = biguint_new(1);
+ * BigUint result = biguint_new(2);
+ * int overflow = biguint_overflow_sqr(a, &result); // Check if `a * a` overflows
+ * ```
+ */
+int biguint_overflow_sqr(BigUint a, BigUint *out);
+
+/**
+ * Squares a BigUint value and stores the result in `out`.
+ *
+ * @param a The BigUint operand.
+ * @param out Pointer to store the result.
+ *
+ * @example
+ * ```
+ * BigUint a = biguint_new(1);
+ * BigUint result = biguint_new(2);
+ * biguint_sqr(a, &result);  // Compute `a * a` and store it in `result`
+ * ```
+ */
+void biguint_sqr(BigUint a, BigUint *out);
+
+/**
+ * Multiplies two BigUint values and stores the lower `out->size` limbs of the product in `out`.
+ *
+ * Unlike `biguint_overflow_mul` it never computes limbs that do not fit in `out`, so it is the cheapest way to obtain
+ * `(a * b) mod 2^(64 * out->size)`.
+ *
+ * @param a The first BigUint operand.
+ * @param b The second BigUint operand.
+ * @param out Pointer to store the result.
+ *
+ * @example
+ * ```
+ * BigUint a = biguint_new(4);
+ * BigUint b = biguint_new(4);
+ * BigUint result = biguint_new(4);
+ * biguint_mul_low(a, b, &result);  // Compute `a * b mod 2^256` and store it in `result`
+ * ```
+ */
+void biguint_mul_low(BigUint a, BigUint b, BigUint *out);
+
+/**
+ * Returns the number of limbs of scratch memory `biguint_mul_with_scratch` needs to multiply `a` by `b` into `out`.
+ *
+ * @param a The first BigUint operand.
+ * @param b The second BigUint operand.
+ * @param out The BigUint that will hold the result.
+ * @return The scratch size in limbs.
+ */
+int biguint_mul_scratch_size(BigUint a, BigUint b, BigUint out);
+
+/**
+ * Multiplies two BigUint values and stores the result in `out`, using a caller supplied scratch buffer instead of
+ * allocating one. Useful to multiply many times operands of the same size without touching the heap.
+ *
+ * @param a The first BigUint operand.
+ * @param b The second BigUint operand.
+ * @param out Pointer to store the result.
+ * @param scratch Buffer of at least `biguint_mul_scratch_size(a, b, *out)` limbs.
+ *
+ * @example
+ * ```
+ * uint64_t *scratch = malloc(biguint_mul_scratch_size(a, b, result) * sizeof(uint64_t));
+ * biguint_mul_with_scratch(a, b, &result, scratch);
+ * free(scratch);
+ * ```
+ */
+void biguint_mul_with_scratch(BigUint a, BigUint b, BigUint *out, uint64_t *scratch);
+
+/**
+ * Enables or disables the assembly limb kernels.
+ *
+ * On x86-64 CPUs supporting BMI2 and ADX, the inner loops of schoolbook multiplication, squaring and montgomery
+ * reduction run on mulx/adcx/adox kernels, which are selected at load time. Disabling them falls back to the portable
+ * C loops, enabling them has no effect on CPUs (or architectures) without support.
+ *
+ * @param enabled 1 to use the assembly kernels when available, 0 to always use the portable ones.
+ */
+void biguint_set_asm_kernels(int enabled);
+
+/**
+ * Returns whether the assembly limb kernels are in use.
+ *
+ * @return 1 if they are, 0 otherwise.
+ */
+int biguint_asm_kernels();
+
+/**
+ * Sets the number of limbs from which multiplications switch from schoolbook to Karatsuba.
+ *
+ * The default is 24 limbs (1536 bits), values lower than 4 are clamped to 4.
+ *
+ * @param limbs The new threshold.
+ */
+void biguint_set_karatsuba_threshold(int limbs);
+
+/**
+ * Returns the number of limbs from which multiplications switch from schoolbook to Karatsuba.
+ *
+ * @return The current threshold.
+ */
+int biguint_karatsuba_threshold();
+
+/**
+ * Sets the number of limbs from which multiplications switch from Karatsuba to Toom-3.
+ *
+ * The default is 256 limbs (16384 bits), values lower than 9 are clamped to 9.
+ *
+ * @param limbs The new threshold.
+ */
+void biguint_set_toom3_threshold(int limbs);
+
+/**
+ * Returns the number of limbs from which multiplications switch from Karatsuba to Toom-3.
+ *
+ * @return The current threshold.
+ */
+int biguint_toom3_threshold();
+
+/**
+ * Sets the number of limbs from which multiplications switch to number theoretic transforms modulo three primes.
+ *
+ * The default is 4096 limbs (262144 bits).
+ *
+ * @param limbs The new threshold.
+ */
+void biguint_set_ntt_threshold(int limbs);
+
+/**
+ * Returns the number of limbs from which multiplications switch to number theoretic transforms.
+ *
+ * @return The current threshold.
+ */
+int biguint_ntt_threshold();
+
+/**
+ * Sets the number of threads a transform based multiplication is split into. Each of the three primes is an
+ * independent job, so values above 3 are clamped to 3. The default is 1, which never spawns threads.
+ *
+ * @param threads The number of threads.
+ */
+void biguint_set_ntt_threads(int threads);
+
+/**
+ * Returns the number of threads a transform based multiplication is split into.
+ *
+ * @return The current number of threads.
+ */
+int biguint_ntt_threads();
+
 /**
  * Computes `(a * b) mod m` and stores the result in `out`.
  *
@@ -438,6 +778,53 @@ void biguint_mul(BigUint a, BigUint b, BigUint *out);
  */
 void biguint_mul_mod(BigUint a, BigUint b, BigUint m, BigUint *out);
 
+/**
+ * Returns the number of workspace limbs `biguint_mul_mod_ws` needs for an n limbs modulus.
+ *
+ * @param n The size of the modulus in limbs.
+ * @return The workspace size in limbs.
+ */
+int biguint_mul_mod_ws_size(int n);
+
+/**
+ * Computes `(a * b) mod m` using a caller provided workspace, and stores the result in `out`.
+ *
+ * The product is never materialized: each limb of `a` is multiplied into the running remainder, which is reduced
+ * right away by a single division step, so nothing is allocated, neither on the heap nor on the scratch arena.
+ * `a` and `b` may be of any size.
+ *
+ * @param a   The first BigUint operand.
+ * @param b   The second BigUint operand.
+ * @param m   The modulus, non zero.
+ * @param out Pointer to store the result.
+ * @param ws  The workspace, at least `biguint_mul_mod_ws_size(m.size)` limbs.
+ *
+ * @example
+ * ```
+ * uint64_t ws[biguint_mul_mod_ws_size(4)];
+ * BigUint result = biguint_new(4);
+ * biguint_mul_mod_ws(a, b, m, &result, ws);  // Compute `(a * b) % m` without allocating
+ * ```
+ */
+void biguint_mul_mod_ws(BigUint a, BigUint b, BigUint m, BigUint *out, uint64_t *ws);
+
+/**
+ * Computes `(a * a) mod m` and stores the result in `out`.
+ *
+ * @param a The BigUint operand.
+ * @param m The modulus.
+ * @param out Pointer to store the result.
+ *
+ * @example
+ * ```
+ * BigUint a = biguint_new(1);
+ * BigUint m = biguint_new(1);
+ * BigUint result = biguint_new(1);
+ * biguint_sqr_mod(a, m, &result);  // Compute `(a * a) % m` and store in `result`
+ * ```
+ */
+void biguint_sqr_mod(BigUint a, BigUint m, BigUint *out);
+
 /**
  * Divides one BigUint by another, storing the quotient and remainder.
  *
@@ -562,6 +949,311 @@ void biguint_pow(BigUint a, BigUint exponent, BigUint *out);
  */
 void biguint_pow_mod(BigUint a, BigUint exponent, BigUint m, BigUint *out);
 
+/**
+ * Computes `outs[i] = (bases[i]^exponents[i]) % moduli[i]` for `count` independent exponentiations.
+ *
+ * On CPUs supporting AVX-512 IFMA, exponentiations with an odd modulus are run eight at a time, one per vector lane,
+ * in a radix 2^52 montgomery representation interleaved across the lanes. Every lane has its own modulus and exponent,
+ * the cost of a group is driven by its largest ones. Other CPUs, even moduli, and disabling the assembly kernels with
+ * `biguint_set_asm_kernels(0)` fall back to `biguint_pow_mod` for each element.
+ *
+ * @param bases The base of each exponentiation.
+ * @param exponents The exponent of each exponentiation.
+ * @param moduli The modulus of each exponentiation.
+ * @param outs Where to store each result, they must not overlap the inputs.
+ * @param count The number of exponentiations.
+ *
+ * @example
+ * ```
+ * BigUint signatures[16], exponents[16], moduli[16], messages[16];
+ * // ... initialize them
+ * biguint_pow_mod_batch(signatures, exponents, moduli, messages, 16);  // RSA verification of 16 signatures
+ * ```
+ */
+void biguint_pow_mod_batch(const BigUint *bases, const BigUint *exponents, const BigUint *moduli, BigUint *outs,
+                           int count);
+
+/**
+ * Computes `(bases[0]^exponents[0] * ... * bases[count - 1]^exponents[count - 1]) % m` and stores it in `out`.
+ *
+ * The exponentiations are interleaved so the squarings are shared: for a few bases each one gets its own sliding
+ * windows (Straus), for many of them the digits of all the exponents are gathered into buckets (Pippenger), whichever
+ * takes fewer multiplications. Two terms thus take the squarings of a single `biguint_pow_mod`.
+ *
+ * @param bases The bases, they are not required to be lower than `m`.
+ * @param exponents The exponent of each base.
+ * @param count The number of bases.
+ * @param m The modulus.
+ * @param out Pointer to store the result.
+ *
+ * @example
+ * ```
+ * BigUint bases[2] = {g, h}, exponents[2] = {a, b};
+ * biguint_multi_pow_mod(bases, exponents, 2, p, &result);  // Compute `(g^a * h^b) % p`
+ * ```
+ *
+ * https://cr.yp.to/papers/pippenger.pdf
+ */
+void biguint_multi_pow_mod(const BigUint *bases, const BigUint *exponents, int count, BigUint m, BigUint *out);
+
+/**
+ * Precomputed values to perform multiplications modulo an odd `m` in the Montgomery domain.
+ *
+ * A value `a` is represented in Montgomery form as `aR mod m`, where `R = 2^(64 * n)` and `n` is the number of
+ * significant limbs of `m`. Products in this form are reduced with shifts and multiplications only, so the modulus can
+ * be reused across many operations without running a single division.
+ *
+ * Fields:
+ * - m: the modulus, trimmed to its significant limbs.
+ * - r2: `R^2 mod m`, used to move values into Montgomery form.
+ * - m_inv: `-m^(-1) mod 2^64`.
+ *
+ * @note
+ * You must call `biguint_mont_ctx_free` to release the memory after use.
+ *
+ * @example
+ * ```
+ * BigUintMontCtx ctx;
+ * biguint_mont_ctx_init(m, &ctx);
+ * biguint_to_mont(a, ctx, &a);
+ * biguint_mont_sqr(a, ctx, &a);
+ * biguint_from_mont(a, ctx, &a);  // a = a^2 mod m
+ * biguint_mont_ctx_free(&ctx);
+ * ```
+ */
+typedef struct {
+    BigUint m;
+    BigUint r2;
+    uint64_t m_inv;
+} BigUintMontCtx;
+
+/**
+ * Initializes a Montgomery context for the odd modulus `m`, allocating its values on the heap.
+ *
+ * @param m The modulus, it must be odd.
+ * @param ctx Pointer to the context to initialize.
+ */
+void biguint_mont_ctx_init(BigUint m, BigUintMontCtx *ctx);
+
+/**
+ * Initializes a Montgomery context for the odd modulus `m`, keeping its values in `limbs` instead of the heap.
+ *
+ * The context must not be freed with `biguint_mont_ctx_free`, it lives as long as `limbs` does.
+ *
+ * @param m The modulus, it must be odd.
+ * @param limbs Storage for the context, at least `2 * m.size` limbs.
+ * @param ctx Pointer to the context to initialize.
+ *
+ * @example
+ * ```
+ * uint64_t limbs[8];
+ * BigUintMontCtx ctx;
+ * biguint_mont_ctx_init_with_limbs(m, limbs, &ctx);  // m of 4 limbs, the context is on the stack
+ * ```
+ */
+void biguint_mont_ctx_init_with_limbs(BigUint m, uint64_t *limbs, BigUintMontCtx *ctx);
+
+/**
+ * Frees the memory allocated by `biguint_mont_ctx_init`.
+ *
+ * @param ctx Pointer to the context to free.
+ */
+void biguint_mont_ctx_free(BigUintMontCtx *ctx);
+
+/**
+ * Computes `a * b * R^(-1) mod m` and stores the result in `out`.
+ *
+ * When `a` and `b` are in Montgomery form, the result is the Montgomery form of their product.
+ *
+ * @param a The first operand, it must be lower than `m`.
+ * @param b The second operand, it must be lower than `m`.
+ * @param ctx The Montgomery context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_mont_mul(BigUint a, BigUint b, BigUintMontCtx ctx, BigUint *out);
+
+/**
+ * Computes `a * a * R^(-1) mod m` and stores the result in `out`.
+ *
+ * Same as `biguint_mont_mul(a, a, ctx, out)` but each cross product is computed only once.
+ *
+ * @param a The operand, it must be lower than `m`.
+ * @param ctx The Montgomery context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_mont_sqr(BigUint a, BigUintMontCtx ctx, BigUint *out);
+
+/**
+ * Converts `a` into Montgomery form (`aR mod m`) and stores the result in `out`.
+ *
+ * @param a The value to convert, it must be lower than `m`.
+ * @param ctx The Montgomery context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_to_mont(BigUint a, BigUintMontCtx ctx, BigUint *out);
+
+/**
+ * Converts `a` out of Montgomery form (`aR^(-1) mod m`) and stores the result in `out`.
+ *
+ * @param a The value in Montgomery form.
+ * @param ctx The Montgomery context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_from_mont(BigUint a, BigUintMontCtx ctx, BigUint *out);
+
+/**
+ * Computes `(a^exponent) mod m` with a precomputed Montgomery context and stores the result in `out`.
+ *
+ * Useful when many exponentiations share the same modulus. `biguint_pow_mod` uses it for every odd modulus.
+ *
+ * @param a The base BigUint, it is not required to be lower than `m`.
+ * @param exponent The exponent BigUint.
+ * @param ctx The Montgomery context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_pow_mod_mont(BigUint a, BigUint exponent, BigUintMontCtx ctx, BigUint *out);
+
+/**
+ * Computes `(bases[0]^exponents[0] * ... * bases[count - 1]^exponents[count - 1]) % m` with a precomputed Montgomery
+ * context, as `biguint_multi_pow_mod` does for every odd modulus.
+ *
+ * @param bases The bases, they are not required to be lower than `m`.
+ * @param exponents The exponent of each base.
+ * @param count The number of bases.
+ * @param ctx The Montgomery context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_multi_pow_mod_mont(const BigUint *bases, const BigUint *exponents, int count, BigUintMontCtx ctx,
+                                BigUint *out);
+
+/**
+ * Precomputed values to perform Barrett reductions modulo `m`.
+ *
+ * Unlike the Montgomery context it works for any modulus, including even ones. Reductions only involve
+ * multiplications by the precomputed `mu = floor(b^(2k) / m)`, where `b = 2^64` and `k` is the number of significant
+ * limbs of `m`.
+ *
+ * Fields:
+ * - m: the modulus, trimmed to its significant limbs.
+ * - mu: `floor(b^(2k) / m)`, stored in `k + 1` limbs.
+ *
+ * @note
+ * You must call `biguint_barrett_ctx_free` to release the memory after use.
+ *
+ * @example
+ * ```
+ * BigUintBarrettCtx ctx;
+ * biguint_barrett_ctx_init(m, &ctx);
+ * biguint_mul_mod_ctx(a, b, ctx, &out);  // out = a * b mod m
+ * biguint_barrett_ctx_free(&ctx);
+ * ```
+ */
+typedef struct {
+    BigUint m;
+    BigUint mu;
+} BigUintBarrettCtx;
+
+/**
+ * Initializes a Barrett context for the modulus `m`, allocating its values on the heap.
+ *
+ * @param m The modulus, it must not be zero.
+ * @param ctx Pointer to the context to initialize.
+ */
+void biguint_barrett_ctx_init(BigUint m, BigUintBarrettCtx *ctx);
+
+/**
+ * Initializes a Barrett context for the modulus `m`, keeping its values in `limbs` instead of the heap.
+ *
+ * The context must not be freed with `biguint_barrett_ctx_free`, it lives as long as `limbs` does.
+ *
+ * @param m The modulus, it must not be zero.
+ * @param limbs Storage for the context, at least `2 * m.size + 1` limbs.
+ * @param ctx Pointer to the context to initialize.
+ *
+ * @example
+ * ```
+ * uint64_t limbs[9];
+ * BigUintBarrettCtx ctx;
+ * biguint_barrett_ctx_init_with_limbs(m, limbs, &ctx);  // m of 4 limbs, the context is on the stack
+ * ```
+ */
+void biguint_barrett_ctx_init_with_limbs(BigUint m, uint64_t *limbs, BigUintBarrettCtx *ctx);
+
+/**
+ * Frees the memory allocated by `biguint_barrett_ctx_init`.
+ *
+ * @param ctx Pointer to the context to free.
+ */
+void biguint_barrett_ctx_free(BigUintBarrettCtx *ctx);
+
+/**
+ * Computes `a mod m` and stores the result in `out`.
+ *
+ * @param a The value to reduce, it can have any size.
+ * @param ctx The Barrett context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_barrett_reduce(BigUint a, BigUintBarrettCtx ctx, BigUint *out);
+
+/**
+ * Computes `(a + b) mod m` and stores the result in `out`.
+ *
+ * Same as `biguint_add_mod`, but the carry of the addition is not lost.
+ *
+ * @param a The first BigUint operand.
+ * @param b The second BigUint operand.
+ * @param ctx The Barrett context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_add_mod_ctx(BigUint a, BigUint b, BigUintBarrettCtx ctx, BigUint *out);
+
+/**
+ * Computes `(a - b) mod m` and stores the result in `out`.
+ *
+ * Unlike `biguint_sub_mod`, when `b > a` the result wraps around `m` instead of `2^(64 * size)`.
+ *
+ * @param a The first BigUint operand.
+ * @param b The second BigUint operand.
+ * @param ctx The Barrett context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_sub_mod_ctx(BigUint a, BigUint b, BigUintBarrettCtx ctx, BigUint *out);
+
+/**
+ * Computes `(a * b) mod m` and stores the result in `out`.
+ *
+ * @param a The first BigUint operand.
+ * @param b The second BigUint operand.
+ * @param ctx The Barrett context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_mul_mod_ctx(BigUint a, BigUint b, BigUintBarrettCtx ctx, BigUint *out);
+
+/**
+ * Computes `(a^exponent) mod m` with a precomputed Barrett context and stores the result in `out`.
+ *
+ * `biguint_pow_mod` uses it for every even modulus.
+ *
+ * @param a The base BigUint.
+ * @param exponent The exponent BigUint.
+ * @param ctx The Barrett context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_pow_mod_barrett(BigUint a, BigUint exponent, BigUintBarrettCtx ctx, BigUint *out);
+
+/**
+ * Computes `(bases[0]^exponents[0] * ... * bases[count - 1]^exponents[count - 1]) % m` with a precomputed Barrett
+ * context, as `biguint_multi_pow_mod` does for every even modulus.
+ *
+ * @param bases The bases.
+ * @param exponents The exponent of each base.
+ * @param count The number of bases.
+ * @param ctx The Barrett context of `m`.
+ * @param out Pointer to store the result.
+ */
+void biguint_multi_pow_mod_barrett(const BigUint *bases, const BigUint *exponents, int count, BigUintBarrettCtx ctx,
+                                   BigUint *out);
+
 /**
  * Computes bitwise AND between `a` and `b` and stores the result in `out`.
  *
@@ -600,6 +1292,8 @@ void biguint_bitnot(BigUint a, BigUint *out);
 /**
  * Performs a right shift on `a` and stores the result in `out`.
  *
+ * `out` may point to `a` itself, the shift is then done in place without any copy.
+ *
  * @param a The BigUint operand.
  * @param shift The number of positions to shift.
  * @param out Pointer to store the result.
@@ -609,6 +1303,8 @@ void biguint_shr(BigUint a, int shift, BigUint *out);
 /**
  * Performs a left shift on `a` and stores the result in `out`.
  *
+ * `out` may point to `a` itself, the shift is then done in place without any copy.
+ *
  * @param a The BigUint operand.
  * @param shift The number of positions to shift.
  * @param out Pointer to store the result.
@@ -0,0 +1,8 @@
+#ifndef U1024_H
+#define U1024_H
+
+#include "uint.h"
+
+DEFINE_UINT(u1024, 16)
+
+#endif
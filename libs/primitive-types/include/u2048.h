@@ -0,0 +1,8 @@
+#ifndef U2048_H
+#define U2048_H
+
+#include "uint.h"
+
+DEFINE_UINT(u2048, 32)
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef U3072_H
+#define U3072_H
+
+#include "uint.h"
+
+DEFINE_UINT(u3072, 48)
+
+#endif
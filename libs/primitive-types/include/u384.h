@@ -0,0 +1,8 @@
+#ifndef U384_H
+#define U384_H
+
+#include "uint.h"
+
+DEFINE_UINT(u384, 6)
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef U4096_H
+#define U4096_H
+
+#include "uint.h"
+
+DEFINE_UINT(u4096, 64)
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef U512_H
+#define U512_H
+
+#include "uint.h"
+
+DEFINE_UINT(u512, 8)
+
+#endif
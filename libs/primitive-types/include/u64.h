@@ -5,6 +5,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+// The limb primitives are defined inline, they are called once per limb in every BigUint loop and are meant to
+// compile down to single add/adc, sub/sbb, mul and lzcnt/tzcnt instructions.
+
 // Result of u64 operations with wrapped result in case of overflow and a
 // boolean indicating if overflow occurred
 // - res: returns the wrapped value in case of overflow
@@ -14,17 +17,78 @@ typedef struct u64_overflow_op {
     int overflow;
 } u64_overflow_op;
 
-u64_overflow_op u64_overflow_add(uint64_t a, uint64_t b);
-u64_overflow_op u64_overflow_sub(uint64_t a, uint64_t b);
-u64_overflow_op u64_overflow_mul(uint64_t a, uint64_t b);
-
 typedef struct u64_mul {
     uint64_t res;
     uint64_t carry;
 } u64_mul_op;
 
-u64_mul_op u64_mul(uint64_t a, uint64_t b);
+static inline u64_overflow_op u64_overflow_add(uint64_t a, uint64_t b) {
+    u64_overflow_op op;
+    op.overflow = __builtin_add_overflow(a, b, &op.res);
+    return op;
+}
+
+static inline u64_overflow_op u64_overflow_sub(uint64_t a, uint64_t b) {
+    u64_overflow_op op;
+    op.overflow = __builtin_sub_overflow(a, b, &op.res);
+    return op;
+}
+
+static inline u64_mul_op u64_mul(uint64_t a, uint64_t b) {
+    __uint128_t res = (__uint128_t)a * b;
+    return (u64_mul_op){.res = (uint64_t)res, .carry = (uint64_t)(res >> 64)};
+}
+
+static inline u64_overflow_op u64_overflow_mul(uint64_t a, uint64_t b) {
+    u64_overflow_op op;
+    op.overflow = __builtin_mul_overflow(a, b, &op.res);
+    return op;
+}
+
+// computes a + b + carry (carry being 0 or 1), the carry of the addition is written into carry_out
+static inline uint64_t u64_addc(uint64_t a, uint64_t b, uint64_t carry, uint64_t *carry_out) {
+    uint64_t res;
+    uint64_t c1 = __builtin_add_overflow(a, b, &res);
+    uint64_t c2 = __builtin_add_overflow(res, carry, &res);
+    *carry_out = c1 | c2;
+    return res;
+}
+
+// computes a - b - borrow (borrow being 0 or 1), the borrow of the subtraction is written into borrow_out
+static inline uint64_t u64_subb(uint64_t a, uint64_t b, uint64_t borrow, uint64_t *borrow_out) {
+    uint64_t res;
+    uint64_t b1 = __builtin_sub_overflow(a, b, &res);
+    uint64_t b2 = __builtin_sub_overflow(res, borrow, &res);
+    *borrow_out = b1 | b2;
+    return res;
+}
+
+static inline int u64_leading_zeros(uint64_t a) { return a == 0 ? 64 : __builtin_clzll(a); }
+
+static inline int u64_trailing_zeros(uint64_t a) { return a == 0 ? 64 : __builtin_ctzll(a); }
+
+// floor((2^128 - 1) / d) - 2^64 for a normalized d (top bit set), the reciprocal that lets `u64_div_2by1_preinv`
+// divide by d with multiplications only
+static inline uint64_t u64_reciprocal(uint64_t d) { return (uint64_t)((((__uint128_t)~d) << 64 | ~0ULL) / d); }
 
-int u64_leading_zeros(uint64_t a);
+// divides u1 * 2^64 + u0 by the normalized d, given its reciprocal and u1 < d, returns the quotient and writes the
+// remainder into rem
+//
+// see Möller and Granlund, Improved division by invariant integers, algorithm 4
+static inline uint64_t u64_div_2by1_preinv(uint64_t u1, uint64_t u0, uint64_t d, uint64_t d_inv, uint64_t *rem) {
+    __uint128_t q = (__uint128_t)d_inv * u1 + ((((__uint128_t)u1) << 64) | u0);
+    uint64_t q1 = (uint64_t)(q >> 64) + 1, q0 = (uint64_t)q;
+    uint64_t r = u0 - q1 * d;
+    if (r > q0) {
+        q1--;
+        r += d;
+    }
+    if (r >= d) {
+        q1++;
+        r -= d;
+    }
+    *rem = r;
+    return q1;
+}
 
 #endif
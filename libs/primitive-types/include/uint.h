@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "biguint.h"
+#include "u64.h"
 
 /**
  * ==============================================================================
@@ -20,9 +21,26 @@
  *   allocation and provide a clean, simple interface.
  * - **More Functional API**: These macros encourage functional programming
  *   practices where operations are performed in a predictable manner.
+ *
+ * Every function is generated `static inline`. The ones on the hot path of
+ * curve and hash code (add, sub, mul, shifts, comparisons and bitwise
+ * operations) are written against the fixed `WORDS` limbs of the type, so the
+ * compiler fully unrolls them and keeps the operands in registers. The rest
+ * view their operands as BigUints and call into the generic implementation.
  * ==============================================================================
  */
 
+/**
+ * Asks the compiler to fully unroll the following fixed width loop.
+ */
+#define UINT_UNROLL _Pragma("GCC unroll 16")
+
+/**
+ * Widest type, in limbs, whose products are computed inline. Wider ones call the BigUint multiplication, whose
+ * assembly kernels and Karatsuba split are faster at those sizes than a fully unrolled schoolbook.
+ */
+#define UINT_INLINE_MUL_WORDS 8
+
 /**
  * Defines a new unsigned integer data type.
  *
@@ -59,7 +77,7 @@
  * the `limbs` field of the structure.
  */
 #define DEFINE_UINT_FROM_LIMBS(NAME, WORDS)                                                                            \
-    NAME NAME##_from_limbs(uint64_t limbs[WORDS], int limbs_size) {                                                    \
+    static inline NAME NAME##_from_limbs(uint64_t limbs[WORDS], int limbs_size) {                                      \
         NAME result = NAME##_zero();                                                                                   \
         int limit;                                                                                                     \
         if (limbs_size < WORDS)                                                                                        \
@@ -81,8 +99,8 @@
  * ```
  */
 #define DEFINE_UINT_FROM_BIGUINT(NAME, WORDS)                                                                          \
-    NAME NAME##_from_biguint(BigUint a) {                                                                              \
-        u256 result = u256_from_limbs(a.limbs, a.size);                                                                \
+    static inline NAME NAME##_from_biguint(BigUint a) {                                                                \
+        NAME result = NAME##_from_limbs(a.limbs, a.size);                                                              \
         return result;                                                                                                 \
     }
 
@@ -122,10 +140,14 @@
  * Returns a structure containing the result and an overflow flag.
  */
 #define DEFINE_UINT_OVERFLOW_ADD(NAME, WORDS)                                                                          \
-    NAME##_overflow_op NAME##_overflow_add(NAME a, NAME b) {                                                           \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        int overflow = biguint_overflow_add(uint_to_biguint(a), uint_to_biguint(b), &result);                          \
-        return (NAME##_overflow_op){.res = NAME##_from_biguint(result), .overflow = overflow};                         \
+    static inline NAME##_overflow_op NAME##_overflow_add(NAME a, NAME b) {                                             \
+        NAME##_overflow_op result;                                                                                     \
+        uint64_t carry = 0;                                                                                            \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++)                                                                                \
+            result.res.limbs[i] = u64_addc(a.limbs[i], b.limbs[i], carry, &carry);                                     \
+        result.overflow = carry != 0;                                                                                  \
+        return result;                                                                                                 \
     }
 
 /** \
@@ -134,10 +156,16 @@
  * Returns the result in mod m.  \
  */
 #define DEFINE_UINT_ADD_MOD(NAME, WORDS)                                                                               \
-    NAME NAME##_add_mod(NAME a, NAME b, NAME m) {                                                                      \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_add_mod(uint_to_biguint(a), uint_to_biguint(b), uint_to_biguint(m), &result);                          \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_add_mod(NAME a, NAME b, NAME m) {                                                        \
+        NAME##_overflow_op sum = NAME##_overflow_add(a, b);                                                            \
+        if (NAME##_cmp(sum.res, m) < 0)                                                                                \
+            return sum.res;                                                                                            \
+        if (!sum.overflow) {                                                                                           \
+            NAME##_overflow_op diff = NAME##_overflow_sub(sum.res, m);                                                 \
+            if (NAME##_cmp(diff.res, m) < 0)                                                                           \
+                return diff.res;                                                                                       \
+        }                                                                                                              \
+        return NAME##_mod(sum.res, m);                                                                                 \
     }
 
 /**                                                                                                                    \
@@ -146,10 +174,14 @@
  * Returns a structure containing the result and an overflow flag.                                                     \
  */                                                                                                                    \
 #define DEFINE_UINT_OVERFLOW_SUB(NAME, WORDS)                                                                          \
-    NAME##_overflow_op NAME##_overflow_sub(NAME a, NAME b) {                                                           \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        int overflow = biguint_overflow_sub(uint_to_biguint(a), uint_to_biguint(b), &result);                          \
-        return (NAME##_overflow_op){.res = NAME##_from_biguint(result), .overflow = overflow};                         \
+    static inline NAME##_overflow_op NAME##_overflow_sub(NAME a, NAME b) {                                             \
+        NAME##_overflow_op result;                                                                                     \
+        uint64_t borrow = 0;                                                                                           \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++)                                                                                \
+            result.res.limbs[i] = u64_subb(a.limbs[i], b.limbs[i], borrow, &borrow);                                   \
+        result.overflow = borrow != 0;                                                                                 \
+        return result;                                                                                                 \
     }
 
 /** \
@@ -158,10 +190,11 @@
  * Returns the result in mod m.  \
  */
 #define DEFINE_UINT_SUB_MOD(NAME, WORDS)                                                                               \
-    NAME NAME##_sub_mod(NAME a, NAME b, NAME m) {                                                                      \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_sub_mod(uint_to_biguint(a), uint_to_biguint(b), uint_to_biguint(m), &result);                          \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_sub_mod(NAME a, NAME b, NAME m) {                                                        \
+        NAME##_overflow_op diff = NAME##_overflow_sub(a, b);                                                           \
+        if (NAME##_cmp(diff.res, m) < 0)                                                                               \
+            return diff.res;                                                                                           \
+        return NAME##_mod(diff.res, m);                                                                                \
     }
 
 /**
@@ -170,10 +203,12 @@
  * Returns the result of `a & b`.
  */
 #define DEFINE_UINT_BITAND(NAME, WORDS)                                                                                \
-    NAME NAME##_bitand(NAME a, NAME b) {                                                                               \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_bitand(uint_to_biguint(a), uint_to_biguint(b), &result);                                               \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_bitand(NAME a, NAME b) {                                                                 \
+        NAME result;                                                                                                   \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++)                                                                                \
+            result.limbs[i] = a.limbs[i] & b.limbs[i];                                                                 \
+        return result;                                                                                                 \
     }
 
 /**
@@ -182,10 +217,12 @@
  * Returns the result of `a | b`.
  */
 #define DEFINE_UINT_BITOR(NAME, WORDS)                                                                                 \
-    NAME NAME##_bitor(NAME a, NAME b) {                                                                                \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_bitor(uint_to_biguint(a), uint_to_biguint(b), &result);                                                \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_bitor(NAME a, NAME b) {                                                                  \
+        NAME result;                                                                                                   \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++)                                                                                \
+            result.limbs[i] = a.limbs[i] | b.limbs[i];                                                                 \
+        return result;                                                                                                 \
     }
 
 /**                                                                                                                    \
@@ -194,10 +231,12 @@
  * Returns the result of `a ^ b`.                                                                                      \
  */                                                                                                                    \
 #define DEFINE_UINT_BITXOR(NAME, WORDS)                                                                                \
-    NAME NAME##_bitxor(NAME a, NAME b) {                                                                               \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_bitxor(uint_to_biguint(a), uint_to_biguint(b), &result);                                               \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_bitxor(NAME a, NAME b) {                                                                 \
+        NAME result;                                                                                                   \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++)                                                                                \
+            result.limbs[i] = a.limbs[i] ^ b.limbs[i];                                                                 \
+        return result;                                                                                                 \
     }
 /**                                                                                                                    \
  * Performs a bitwise NOT operation.                                                                                   \
@@ -205,10 +244,115 @@
  * Returns the result of `~a`.                                                                                         \
  */                                                                                                                    \
 #define DEFINE_UINT_BITNOT(NAME, WORDS)                                                                                \
-    NAME NAME##_bitnot(NAME a) {                                                                                       \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_bitnot(uint_to_biguint(a), &result);                                                                   \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_bitnot(NAME a) {                                                                         \
+        NAME result;                                                                                                   \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++)                                                                                \
+            result.limbs[i] = ~a.limbs[i];                                                                             \
+        return result;                                                                                                 \
+    }
+
+/**
+ * Multiplies two unsigned integers into their full `2 * WORDS` limbs product.
+ *
+ * Schoolbook multiplication, one row of `WORDS` multiply-accumulates per limb of `b`, for types up to
+ * `UINT_INLINE_MUL_WORDS` limbs.
+ */
+#define DEFINE_UINT_WIDENING_MUL(NAME, WORDS)                                                                          \
+    static inline void NAME##_widening_mul(NAME a, NAME b, uint64_t out[WORDS * 2]) {                                  \
+        if (WORDS > UINT_INLINE_MUL_WORDS) {                                                                           \
+            BigUint product = {.size = WORDS * 2, .limbs = out};                                                       \
+            biguint_mul(uint_to_biguint(a), uint_to_biguint(b), &product);                                             \
+            return;                                                                                                    \
+        }                                                                                                              \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++)                                                                                \
+            out[i] = 0;                                                                                                \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++) {                                                                              \
+            uint64_t carry = 0;                                                                                        \
+            UINT_UNROLL                                                                                                \
+            for (int j = 0; j < WORDS; j++) {                                                                          \
+                __uint128_t t = (__uint128_t)a.limbs[j] * b.limbs[i] + out[i + j] + carry;                             \
+                out[i + j] = (uint64_t)t;                                                                              \
+                carry = (uint64_t)(t >> 64);                                                                           \
+            }                                                                                                          \
+            out[i + WORDS] = carry;                                                                                    \
+        }                                                                                                              \
+    }
+
+/**
+ * Squares an unsigned integer into its full `2 * WORDS` limbs product.
+ *
+ * The cross products `a[i] * a[j]` with `i < j` are computed once and doubled, then the squares of each limb are
+ * added along the diagonal.
+ */
+#define DEFINE_UINT_WIDENING_SQR(NAME, WORDS)                                                                          \
+    static inline void NAME##_widening_sqr(NAME a, uint64_t out[WORDS * 2]) {                                          \
+        if (WORDS > UINT_INLINE_MUL_WORDS) {                                                                           \
+            BigUint product = {.size = WORDS * 2, .limbs = out};                                                       \
+            biguint_sqr(uint_to_biguint(a), &product);                                                                 \
+            return;                                                                                                    \
+        }                                                                                                              \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS * 2; i++)                                                                            \
+            out[i] = 0;                                                                                                \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS - 1; i++) {                                                                          \
+            uint64_t carry = 0;                                                                                        \
+            UINT_UNROLL                                                                                                \
+            for (int j = i + 1; j < WORDS; j++) {                                                                      \
+                __uint128_t t = (__uint128_t)a.limbs[i] * a.limbs[j] + out[i + j] + carry;                             \
+                out[i + j] = (uint64_t)t;                                                                              \
+                carry = (uint64_t)(t >> 64);                                                                           \
+            }                                                                                                          \
+            out[i + WORDS] = carry;                                                                                    \
+        }                                                                                                              \
+        UINT_UNROLL                                                                                                    \
+        for (int i = WORDS * 2 - 1; i > 0; i--)                                                                        \
+            out[i] = (out[i] << 1) | (out[i - 1] >> 63);                                                               \
+        out[0] <<= 1;                                                                                                  \
+        uint64_t carry = 0;                                                                                            \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++) {                                                                              \
+            __uint128_t sqr = (__uint128_t)a.limbs[i] * a.limbs[i];                                                    \
+            out[i * 2] = u64_addc(out[i * 2], (uint64_t)sqr, carry, &carry);                                           \
+            out[i * 2 + 1] = u64_addc(out[i * 2 + 1], (uint64_t)(sqr >> 64), carry, &carry);                           \
+        }                                                                                                              \
+    }
+
+/**
+ * Truncates a `2 * WORDS` limbs product to `WORDS` limbs.
+ *
+ * Returns a structure containing the low limbs and whether any of the high ones was set.
+ */
+#define DEFINE_UINT_FROM_PRODUCT(NAME, WORDS)                                                                          \
+    static inline NAME##_overflow_op NAME##_from_product(uint64_t product[WORDS * 2]) {                                \
+        NAME##_overflow_op result;                                                                                     \
+        uint64_t high = 0;                                                                                             \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++) {                                                                              \
+            result.res.limbs[i] = product[i];                                                                          \
+            high |= product[i + WORDS];                                                                                \
+        }                                                                                                              \
+        result.overflow = high != 0;                                                                                   \
+        return result;                                                                                                 \
+    }
+
+/**
+ * Reduces a `2 * WORDS` limbs product modulo m.
+ *
+ * Products already below m are returned as they are, the others go through a long division.
+ */
+#define DEFINE_UINT_REDUCE_PRODUCT(NAME, WORDS)                                                                        \
+    static inline NAME NAME##_reduce_product(uint64_t product[WORDS * 2], NAME m) {                                    \
+        NAME##_overflow_op low = NAME##_from_product(product);                                                         \
+        if (!low.overflow && NAME##_cmp(low.res, m) < 0)                                                               \
+            return low.res;                                                                                            \
+        NAME result;                                                                                                   \
+        BigUint rem = uint_to_biguint(result);                                                                         \
+        biguint_mod((BigUint){.size = WORDS * 2, .limbs = product}, uint_to_biguint(m), &rem);                         \
+        return result;                                                                                                 \
     }
 
 /** \
@@ -217,22 +361,136 @@
  * Returns a structure containing the result and an overflow flag. \
  */
 #define DEFINE_UINT_OVERFLOW_MUL(NAME, WORDS)                                                                          \
-    NAME##_overflow_op NAME##_overflow_mul(NAME a, NAME b) {                                                           \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        int overflow = biguint_overflow_mul(uint_to_biguint(a), uint_to_biguint(b), &result);                          \
-        return (NAME##_overflow_op){.res = NAME##_from_biguint(result), .overflow = overflow};                         \
+    static inline NAME##_overflow_op NAME##_overflow_mul(NAME a, NAME b) {                                             \
+        uint64_t product[WORDS * 2];                                                                                   \
+        NAME##_widening_mul(a, b, product);                                                                            \
+        return NAME##_from_product(product);                                                                           \
     }
 
-/** \
- * Multiplies two unsigned integers over modulus m. \
- *                                                                                                       \
- * Returns the result in mod m.  \
+/**
+ * Multiplies two unsigned integers over modulus m.
+ *
+ * The limbs of a are multiplied into a running remainder one at a time, each followed by a single quotient digit that
+ * brings it back below m, all of it on fixed size arrays. Wide types, moduli with a zero top limb and b >= m multiply
+ * first and divide the product after.
+ *
+ * Returns the result in mod m.
  */
 #define DEFINE_UINT_MUL_MOD(NAME, WORDS)                                                                               \
-    NAME NAME##_mul_mod(NAME a, NAME b, NAME m) {                                                                      \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_mul_mod(uint_to_biguint(a), uint_to_biguint(b), uint_to_biguint(m), &result);                          \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_mul_mod(NAME a, NAME b, NAME m) {                                                        \
+        if (WORDS > UINT_INLINE_MUL_WORDS || m.limbs[WORDS - 1] == 0 || NAME##_cmp(b, m) >= 0) {                       \
+            uint64_t product[WORDS * 2];                                                                               \
+            NAME##_widening_mul(a, b, product);                                                                        \
+            return NAME##_reduce_product(product, m);                                                                  \
+        }                                                                                                              \
+                                                                                                                       \
+        /* v = m * 2^s and bs = b * 2^s, the remainder r * 2^s mod v is kept in x[1..WORDS] */                         \
+        int shift = u64_leading_zeros(m.limbs[WORDS - 1]);                                                             \
+        uint64_t v[WORDS], bs[WORDS], x[WORDS + 2] = {0};                                                              \
+        UINT_UNROLL                                                                                                    \
+        for (int i = WORDS - 1; i > 0; i--) {                                                                          \
+            v[i] = (m.limbs[i] << shift) | ((m.limbs[i - 1] >> 1) >> (63 - shift));                                    \
+            bs[i] = (b.limbs[i] << shift) | ((b.limbs[i - 1] >> 1) >> (63 - shift));                                   \
+        }                                                                                                              \
+        v[0] = m.limbs[0] << shift;                                                                                    \
+        bs[0] = b.limbs[0] << shift;                                                                                   \
+        uint64_t v_inv = u64_reciprocal(v[WORDS - 1]);                                                                 \
+                                                                                                                       \
+        for (int i = WORDS - 1; i >= 0; i--) {                                                                         \
+            /* x = r * 2^64 + a_i * bs, below 2^65 * v */                                                              \
+            uint64_t carry = 0;                                                                                        \
+            x[0] = 0;                                                                                                  \
+            UINT_UNROLL                                                                                                \
+            for (int j = 0; j < WORDS; j++) {                                                                          \
+                __uint128_t p = (__uint128_t)a.limbs[i] * bs[j] + x[j] + carry;                                        \
+                x[j] = (uint64_t)p;                                                                                    \
+                carry = (uint64_t)(p >> 64);                                                                           \
+            }                                                                                                          \
+            x[WORDS] = u64_addc(x[WORDS], carry, 0, &x[WORDS + 1]);                                                    \
+                                                                                                                       \
+            /* subtracting 2^64 * v at most once leaves a single quotient digit */                                     \
+            int above = x[WORDS + 1] != 0, decided = above;                                                            \
+            for (int j = WORDS - 1; j >= 0 && !decided; j--) {                                                         \
+                decided = x[j + 1] != v[j];                                                                            \
+                above = x[j + 1] > v[j];                                                                               \
+            }                                                                                                          \
+            if (above || !decided) {                                                                                   \
+                uint64_t borrow = 0;                                                                                   \
+                UINT_UNROLL                                                                                            \
+                for (int j = 0; j < WORDS; j++)                                                                        \
+                    x[j + 1] = u64_subb(x[j + 1], v[j], borrow, &borrow);                                              \
+                x[WORDS + 1] -= borrow;                                                                                \
+            }                                                                                                          \
+                                                                                                                       \
+            /* estimate the digit from the top limbs, it is off by 2 at most */                                        \
+            uint64_t q, rhat;                                                                                          \
+            int rhat_overflow = 0;                                                                                     \
+            if (x[WORDS] >= v[WORDS - 1]) {                                                                            \
+                q = ~0ULL;                                                                                             \
+                rhat = u64_addc(x[WORDS - 1], v[WORDS - 1], 0, &carry);                                                \
+                rhat_overflow = carry != 0;                                                                            \
+            } else {                                                                                                   \
+                q = u64_div_2by1_preinv(x[WORDS], x[WORDS - 1], v[WORDS - 1], v_inv, &rhat);                           \
+            }                                                                                                          \
+            while (!rhat_overflow &&                                                                                   \
+                   (__uint128_t)q * v[WORDS - 2] > ((((__uint128_t)rhat) << 64) | x[WORDS - 2])) {                     \
+                q--;                                                                                                   \
+                rhat = u64_addc(rhat, v[WORDS - 1], 0, &carry);                                                        \
+                rhat_overflow = carry != 0;                                                                            \
+            }                                                                                                          \
+                                                                                                                       \
+            /* x -= q * v, adding v back if the digit was still one too large */                                       \
+            uint64_t mul_carry = 0, borrow = 0;                                                                        \
+            UINT_UNROLL                                                                                                \
+            for (int j = 0; j < WORDS; j++) {                                                                          \
+                __uint128_t p = (__uint128_t)q * v[j] + mul_carry;                                                     \
+                mul_carry = (uint64_t)(p >> 64);                                                                       \
+                x[j] = u64_subb(x[j], (uint64_t)p, borrow, &borrow);                                                   \
+            }                                                                                                          \
+            x[WORDS] = u64_subb(x[WORDS], mul_carry, borrow, &borrow);                                                 \
+            if (borrow) {                                                                                              \
+                carry = 0;                                                                                             \
+                UINT_UNROLL                                                                                            \
+                for (int j = 0; j < WORDS; j++)                                                                        \
+                    x[j] = u64_addc(x[j], v[j], carry, &carry);                                                        \
+            }                                                                                                          \
+                                                                                                                       \
+            UINT_UNROLL                                                                                                \
+            for (int j = WORDS; j > 0; j--)                                                                            \
+                x[j] = x[j - 1];                                                                                       \
+        }                                                                                                              \
+                                                                                                                       \
+        NAME result;                                                                                                   \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS - 1; i++)                                                                            \
+            result.limbs[i] = (x[i + 1] >> shift) | ((x[i + 2] << 1) << (63 - shift));                                 \
+        result.limbs[WORDS - 1] = x[WORDS] >> shift;                                                                   \
+        return result;                                                                                                 \
+    }
+
+/**
+ * Squares an unsigned integer and detects overflow.
+ *
+ * Faster than `NAME_overflow_mul(a, a)`, as each cross product is computed only once.
+ * Returns a structure containing the result and an overflow flag.
+ */
+#define DEFINE_UINT_OVERFLOW_SQR(NAME, WORDS)                                                                          \
+    static inline NAME##_overflow_op NAME##_overflow_sqr(NAME a) {                                                     \
+        uint64_t product[WORDS * 2];                                                                                   \
+        NAME##_widening_sqr(a, product);                                                                               \
+        return NAME##_from_product(product);                                                                           \
+    }
+
+/**
+ * Squares an unsigned integer over modulus m.
+ *
+ * Returns the result in mod m.
+ */
+#define DEFINE_UINT_SQR_MOD(NAME, WORDS)                                                                               \
+    static inline NAME NAME##_sqr_mod(NAME a, NAME m) {                                                                \
+        uint64_t product[WORDS * 2];                                                                                   \
+        NAME##_widening_sqr(a, product);                                                                               \
+        return NAME##_reduce_product(product, m);                                                                      \
     }
 
 /** \
@@ -241,7 +499,7 @@
  * Returns a structure containing the result and an overflow flag. \
  */
 #define DEFINE_UINT_OVERFLOW_POW(NAME, WORDS)                                                                          \
-    NAME##_overflow_op NAME##_overflow_pow(NAME a, NAME exponent) {                                                    \
+    static inline NAME##_overflow_op NAME##_overflow_pow(NAME a, NAME exponent) {                                      \
         BigUint result = biguint_new(WORDS);                                                                           \
         int overflow = biguint_overflow_pow(uint_to_biguint(a), uint_to_biguint(exponent), &result);                   \
         return (NAME##_overflow_op){.res = NAME##_from_biguint(result), .overflow = overflow};                         \
@@ -250,12 +508,23 @@
 /** \
  * Calculates the power of two unsigned integers over a mod m. \
  *                                                                                                       \
+ * Odd moduli run in the Montgomery domain with the context on the stack, so nothing is allocated on the heap besides \
+ * the growth of the thread's scratch arena, which holds the power table. \
+ *                                                                                                       \
  * Returns the result in mod m. \
  */
 #define DEFINE_UINT_OVERFLOW_POW_MOD(NAME, WORDS)                                                                      \
-    NAME NAME##_pow_mod(NAME a, NAME exponent, NAME m) {                                                               \
+    static inline NAME NAME##_pow_mod(NAME a, NAME exponent, NAME m) {                                                 \
         BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_pow_mod(uint_to_biguint(a), uint_to_biguint(exponent), uint_to_biguint(m), &result);                   \
+        if (biguint_is_zero(uint_to_biguint(exponent)) || biguint_is_even(uint_to_biguint(m))) {                       \
+            biguint_pow_mod(uint_to_biguint(a), uint_to_biguint(exponent), uint_to_biguint(m), &result);               \
+            return NAME##_from_biguint(result);                                                                        \
+        }                                                                                                              \
+        /* odd moduli get their montgomery context on the stack, sized by the width */                                 \
+        uint64_t ctx_limbs[WORDS * 2];                                                                                 \
+        BigUintMontCtx ctx;                                                                                            \
+        biguint_mont_ctx_init_with_limbs(uint_to_biguint(m), ctx_limbs, &ctx);                                         \
+        biguint_pow_mod_mont(uint_to_biguint(a), uint_to_biguint(exponent), ctx, &result);                             \
         return NAME##_from_biguint(result);                                                                            \
     }
 
@@ -265,7 +534,14 @@
  * Returns the number of bits required to represent `a`. \
  */
 #define DEFINE_UINT_BITS(NAME, WORDS)                                                                                  \
-    int NAME##_bits(NAME a) { return biguint_bits(uint_to_biguint(a)); }
+    static inline int NAME##_bits(NAME a) {                                                                            \
+        UINT_UNROLL                                                                                                    \
+        for (int i = WORDS - 1; i >= 0; i--) {                                                                         \
+            if (a.limbs[i] != 0)                                                                                       \
+                return i * 64 + 64 - u64_leading_zeros(a.limbs[i]);                                                    \
+        }                                                                                                              \
+        return 0;                                                                                                      \
+    }
 
 /** \
  * Shifts the unsigned integer left by the specified number of bits. \
@@ -273,10 +549,17 @@
  * Returns the result of shifting `a` by `shift` bits to the left. \
  */
 #define DEFINE_UINT_SHL(NAME, WORDS)                                                                                   \
-    NAME NAME##_shl(NAME a, int shift) {                                                                               \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_shl(uint_to_biguint(a), shift, &result);                                                               \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_shl(NAME a, int shift) {                                                                 \
+        NAME result;                                                                                                   \
+        int limbs = shift / 64, bits = shift % 64;                                                                     \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++) {                                                                              \
+            int src = i - limbs;                                                                                       \
+            uint64_t high = src >= 0 ? a.limbs[src] << bits : 0;                                                       \
+            uint64_t low = bits != 0 && src >= 1 ? a.limbs[src - 1] >> (64 - bits) : 0;                                \
+            result.limbs[i] = high | low;                                                                              \
+        }                                                                                                              \
+        return result;                                                                                                 \
     }
 
 /** \
@@ -285,10 +568,17 @@
  * Returns the result of shifting `a` by `shift` bits to the right. \
  */
 #define DEFINE_UINT_SHR(NAME, WORDS)                                                                                   \
-    NAME NAME##_shr(NAME a, int shift) {                                                                               \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_shr(uint_to_biguint(a), shift, &result);                                                               \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_shr(NAME a, int shift) {                                                                 \
+        NAME result;                                                                                                   \
+        int limbs = shift / 64, bits = shift % 64;                                                                     \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++) {                                                                              \
+            int src = i + limbs;                                                                                       \
+            uint64_t low = src < WORDS ? a.limbs[src] >> bits : 0;                                                     \
+            uint64_t high = bits != 0 && src + 1 < WORDS ? a.limbs[src + 1] << (64 - bits) : 0;                        \
+            result.limbs[i] = low | high;                                                                              \
+        }                                                                                                              \
+        return result;                                                                                                 \
     }
 
 /** \
@@ -298,7 +588,7 @@
  * Returns a structure containing the quotient and remainder of `a / b`. \
  */
 #define DEFINE_UINT_DIV_MOD(NAME, WORDS)                                                                               \
-    NAME##_div_op NAME##_divmod(NAME a, NAME b) {                                                                      \
+    static inline NAME##_div_op NAME##_divmod(NAME a, NAME b) {                                                        \
         BigUint quot = biguint_new(WORDS);                                                                             \
         BigUint rem = biguint_new(WORDS);                                                                              \
         biguint_divmod(uint_to_biguint(a), uint_to_biguint(b), &quot, &rem);                                           \
@@ -309,7 +599,7 @@
  * Divides one unsigned integer by another, returning the remainder only
  */
 #define DEFINE_UINT_DIV(NAME, WORDS)                                                                                   \
-    NAME NAME##_div(NAME a, NAME b) {                                                                                  \
+    static inline NAME NAME##_div(NAME a, NAME b) {                                                                    \
         BigUint quot = biguint_new(WORDS);                                                                             \
         biguint_div(uint_to_biguint(a), uint_to_biguint(b), &quot);                                                    \
         return NAME##_from_biguint(quot);                                                                              \
@@ -319,7 +609,7 @@
  * Divides one unsigned integer by another, returning the remainder only
  */
 #define DEFINE_UINT_MOD(NAME, WORDS)                                                                                   \
-    NAME NAME##_mod(NAME a, NAME b) {                                                                                  \
+    static inline NAME NAME##_mod(NAME a, NAME b) {                                                                    \
         BigUint rem = biguint_new(WORDS);                                                                              \
         biguint_mod(uint_to_biguint(a), uint_to_biguint(b), &rem);                                                     \
         return NAME##_from_biguint(rem);                                                                               \
@@ -331,10 +621,10 @@
  * - 0 if its odd
  */
 #define DEFINE_UINT_IS_EVEN(NAME, WORDS)                                                                               \
-    int NAME##_is_even(NAME a) { return biguint_is_even(uint_to_biguint(a)); }
+    static inline int NAME##_is_even(NAME a) { return (a.limbs[0] & 1) == 0; }
 
 #define DEFINE_UINT_ZERO(NAME, WORDS)                                                                                  \
-    NAME NAME##_zero() {                                                                                               \
+    static inline NAME NAME##_zero() {                                                                                 \
         NAME result = {0};                                                                                             \
         return result;                                                                                                 \
     }
@@ -345,45 +635,93 @@
  * Returns the unsigned integer represented by the string `str`. \
  */
 #define DEFINE_UINT_FROM_DEC_STRING(NAME, WORDS)                                                                       \
-    NAME NAME##_from_dec_string(char *str) {                                                                           \
+    static inline NAME NAME##_from_dec_string(char *str) {                                                             \
         BigUint result = biguint_new(WORDS);                                                                           \
         biguint_from_dec_string(str, &result);                                                                         \
         return NAME##_from_biguint(result);                                                                            \
     }
 
 #define DEFINE_UINT_FROM_U64(NAME, WORDS)                                                                              \
-    NAME NAME##_from_u64(uint64_t a) {                                                                                 \
-        BigUint result = biguint_new(WORDS);                                                                           \
-        biguint_from_u64(a, &result);                                                                                  \
-        return NAME##_from_biguint(result);                                                                            \
+    static inline NAME NAME##_from_u64(uint64_t a) {                                                                   \
+        NAME result = NAME##_zero();                                                                                   \
+        result.limbs[0] = a;                                                                                           \
+        return result;                                                                                                 \
     }
 
 #define DEFINE_UINT_FROM_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                 \
-    NAME NAME##_from_bytes_big_endian(uint8_t *bytes) {                                                                \
+    static inline NAME NAME##_from_bytes_big_endian(uint8_t *bytes) {                                                  \
         BigUint result = biguint_new(WORDS);                                                                           \
         biguint_from_bytes_big_endian(bytes, &result);                                                                 \
         return NAME##_from_biguint(result);                                                                            \
     }
 
 #define DEFINE_UINT_GET_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                  \
-    void NAME##_get_bytes_big_endian(uint8_t *buffer, NAME value) {                                                    \
+    static inline void NAME##_get_bytes_big_endian(uint8_t *buffer, NAME value) {                                      \
         biguint_get_bytes_big_endian(uint_to_biguint(value), buffer);                                                  \
     }
 
 #define DEFINE_UINT_FROM_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                              \
-    NAME NAME##_from_bytes_little_endian(uint8_t bytes[32]) {                                                          \
+    static inline NAME NAME##_from_bytes_little_endian(uint8_t bytes[WORDS * 8]) {                                     \
         BigUint result = biguint_new(WORDS);                                                                           \
         biguint_from_bytes_little_endian(bytes, &result);                                                              \
         return NAME##_from_biguint(result);                                                                            \
     }
 
 #define DEFINE_UINT_GET_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                               \
-    void NAME##_get_bytes_little_endian(uint8_t *buffer, NAME value) {                                                 \
+    static inline void NAME##_get_bytes_little_endian(uint8_t *buffer, NAME value) {                                   \
         biguint_get_bytes_little_endian(uint_to_biguint(value), buffer);                                               \
     }
 
+/**
+ * Reads an unsigned integer from `len` big-endian bytes, any length as long as the value fits.
+ *
+ * Returns 0 on success, -1 when the value does not fit, leaving `out` at zero.
+ */
+#define DEFINE_UINT_READ_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                 \
+    static inline int NAME##_read_bytes_big_endian(const uint8_t *bytes, int len, NAME *out) {                         \
+        BigUint result = {.size = WORDS, .limbs = out->limbs};                                                         \
+        return biguint_read_bytes_big_endian(bytes, len, &result);                                                     \
+    }
+
+#define DEFINE_UINT_WRITE_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                \
+    static inline int NAME##_write_bytes_big_endian(NAME value, uint8_t *buffer, int len) {                            \
+        return biguint_write_bytes_big_endian(uint_to_biguint(value), buffer, len);                                    \
+    }
+
+#define DEFINE_UINT_READ_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                              \
+    static inline int NAME##_read_bytes_little_endian(const uint8_t *bytes, int len, NAME *out) {                      \
+        BigUint result = {.size = WORDS, .limbs = out->limbs};                                                         \
+        return biguint_read_bytes_little_endian(bytes, len, &result);                                                  \
+    }
+
+#define DEFINE_UINT_WRITE_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                             \
+    static inline int NAME##_write_bytes_little_endian(NAME value, uint8_t *buffer, int len) {                         \
+        return biguint_write_bytes_little_endian(uint_to_biguint(value), buffer, len);                                 \
+    }
+
+/**
+ * Parses an unsigned integer from `len` hexadecimal digits, optionally prefixed by `0x`.
+ *
+ * Returns 0 on success, -1 when the string is not valid hex or the value does not fit, leaving `out` at zero.
+ */
+#define DEFINE_UINT_FROM_HEX(NAME, WORDS)                                                                              \
+    static inline int NAME##_from_hex(const char *str, int len, NAME *out) {                                           \
+        BigUint result = {.size = WORDS, .limbs = out->limbs};                                                         \
+        return biguint_from_hex(str, len, &result);                                                                    \
+    }
+
+/**
+ * Writes the lowercase hexadecimal representation of the unsigned integer into `buffer`, null terminated.
+ *
+ * Returns the number of digits written, or -1 when `size` is too small, `WORDS * 16 + 1` always being enough.
+ */
+#define DEFINE_UINT_WRITE_HEX(NAME, WORDS)                                                                             \
+    static inline int NAME##_write_hex(NAME a, char *buffer, int size) {                                               \
+        return biguint_write_hex(uint_to_biguint(a), buffer, size);                                                    \
+    }
+
 #define DEFINE_UINT_ONE(NAME, WORDS)                                                                                   \
-    NAME NAME##_one() {                                                                                                \
+    static inline NAME NAME##_one() {                                                                                  \
         NAME result = NAME##_zero();                                                                                   \
         result.limbs[0] = 1;                                                                                           \
         return result;                                                                                                 \
@@ -396,7 +734,7 @@
  * sure to free the pointer after using it.
  */
 #define DEFINE_UINT_TO_STRING(NAME, WORDS)                                                                             \
-    char *NAME##_to_dec_string(NAME a) { return biguint_to_dec_string(uint_to_biguint(a)); }
+    static inline char *NAME##_to_dec_string(NAME a) { return biguint_to_dec_string(uint_to_biguint(a)); }
 
 /**
  * @def DEFINE_UINT_COMPARE(NAME, WORDS)
@@ -418,79 +756,104 @@
  * - Returns `1` if `a > b`
  */
 #define DEFINE_UINT_COMPARE(NAME, WORDS)                                                                               \
-    int NAME##_cmp(NAME a, NAME b) { return biguint_cmp(uint_to_biguint(a), uint_to_biguint(b)); }
+    static inline int NAME##_cmp(NAME a, NAME b) {                                                                     \
+        UINT_UNROLL                                                                                                    \
+        for (int i = WORDS - 1; i >= 0; i--) {                                                                         \
+            if (a.limbs[i] != b.limbs[i])                                                                              \
+                return a.limbs[i] > b.limbs[i] ? 1 : -1;                                                               \
+        }                                                                                                              \
+        return 0;                                                                                                      \
+    }
 
 /**                                                                                                                    \
  * Prints an array-like format of the internal                                                                         \
  * `parts` array of the `NAME` structure.                                                                              \
  */                                                                                                                    \
 #define DEFINE_UINT_RAW_PRINTLN(NAME, WORDS)                                                                           \
-    void NAME##_raw_println(NAME a) { biguint_raw_println(uint_to_biguint(a)); }
+    static inline void NAME##_raw_println(NAME a) { biguint_raw_println(uint_to_biguint(a)); }
 
 /**                                                                                                                    \
  * Print the string representation of the structure followed by a newline.                                             \
  */                                                                                                                    \
 #define DEFINE_UINT_RAW_PRINT(NAME, WORDS)                                                                             \
-    void NAME##_raw_print(NAME a) { biguint_raw_print(uint_to_biguint(a)); }
+    static inline void NAME##_raw_print(NAME a) { biguint_raw_print(uint_to_biguint(a)); }
 
 /**                                                                                                                    \
  * Print the string representation of the structure.                                                                   \
  */                                                                                                                    \
 #define DEFINE_UINT_PRINTLN(NAME, WORDS)                                                                               \
-    void NAME##_println(NAME a) { biguint_println(uint_to_biguint(a)); }
+    static inline void NAME##_println(NAME a) { biguint_println(uint_to_biguint(a)); }
 
 /**                                                                                                                    \
  * Print the string representation of the structure.                                                                   \
  */                                                                                                                    \
 #define DEFINE_UINT_PRINT(NAME, WORDS)                                                                                 \
-    void NAME##_print(NAME a) { biguint_print(uint_to_biguint(a)); }
+    static inline void NAME##_print(NAME a) { biguint_print(uint_to_biguint(a)); }
 /**
  * Given the UINT `a`
  * Returns:
  * - 1 if `a` is zero.
  * - 0 otherwise.
  */
-#define DEFINE_UINT_IS_ZERO(NAME)                                                                                      \
-    int NAME##_is_zero(NAME a) { return biguint_is_zero(uint_to_biguint(a)); }
+#define DEFINE_UINT_IS_ZERO(NAME, WORDS)                                                                               \
+    static inline int NAME##_is_zero(NAME a) {                                                                         \
+        uint64_t limbs = 0;                                                                                            \
+        UINT_UNROLL                                                                                                    \
+        for (int i = 0; i < WORDS; i++)                                                                                \
+            limbs |= a.limbs[i];                                                                                       \
+        return limbs == 0;                                                                                             \
+    }
 
 #define DEFINE_UINT(NAME, WORDS)                                                                                       \
     DEFINE_UINT_DATA_TYPE(NAME, WORDS)                                                                                 \
     DEFINE_UINT_OVERFLOW_OP(NAME)                                                                                      \
     DEFINE_UINT_DIV_OP(NAME)                                                                                           \
     DEFINE_UINT_ZERO(NAME, WORDS)                                                                                      \
+    DEFINE_UINT_ONE(NAME, WORDS)                                                                                       \
     DEFINE_UINT_FROM_LIMBS(NAME, WORDS)                                                                                \
     DEFINE_UINT_FROM_BIGUINT(NAME, WORDS)                                                                              \
-    DEFINE_UINT_OVERFLOW_ADD(NAME, WORDS)                                                                              \
-    DEFINE_UINT_ADD_MOD(NAME, WORDS)                                                                                   \
-    DEFINE_UINT_COMPARE(NAME, WORDS)                                                                                   \
-    DEFINE_UINT_RAW_PRINTLN(NAME, WORDS)                                                                               \
-    DEFINE_UINT_RAW_PRINT(NAME, WORDS)                                                                                 \
-    DEFINE_UINT_ONE(NAME, WORDS)                                                                                       \
-    DEFINE_UINT_IS_ZERO(NAME)                                                                                          \
     DEFINE_UINT_FROM_U64(NAME, WORDS)                                                                                  \
-    DEFINE_UINT_FROM_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                     \
-    DEFINE_UINT_FROM_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                                  \
-    DEFINE_UINT_GET_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                      \
-    DEFINE_UINT_GET_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                                   \
+    DEFINE_UINT_COMPARE(NAME, WORDS)                                                                                   \
+    DEFINE_UINT_IS_ZERO(NAME, WORDS)                                                                                   \
+    DEFINE_UINT_IS_EVEN(NAME, WORDS)                                                                                   \
+    DEFINE_UINT_BITS(NAME, WORDS)                                                                                      \
+    DEFINE_UINT_OVERFLOW_ADD(NAME, WORDS)                                                                              \
     DEFINE_UINT_OVERFLOW_SUB(NAME, WORDS)                                                                              \
-    DEFINE_UINT_SUB_MOD(NAME, WORDS)                                                                                   \
+    DEFINE_UINT_WIDENING_MUL(NAME, WORDS)                                                                              \
+    DEFINE_UINT_WIDENING_SQR(NAME, WORDS)                                                                              \
+    DEFINE_UINT_FROM_PRODUCT(NAME, WORDS)                                                                              \
     DEFINE_UINT_OVERFLOW_MUL(NAME, WORDS)                                                                              \
+    DEFINE_UINT_OVERFLOW_SQR(NAME, WORDS)                                                                              \
+    DEFINE_UINT_DIV_MOD(NAME, WORDS)                                                                                   \
+    DEFINE_UINT_DIV(NAME, WORDS)                                                                                       \
+    DEFINE_UINT_MOD(NAME, WORDS)                                                                                       \
+    DEFINE_UINT_ADD_MOD(NAME, WORDS)                                                                                   \
+    DEFINE_UINT_SUB_MOD(NAME, WORDS)                                                                                   \
+    DEFINE_UINT_REDUCE_PRODUCT(NAME, WORDS)                                                                            \
     DEFINE_UINT_MUL_MOD(NAME, WORDS)                                                                                   \
+    DEFINE_UINT_SQR_MOD(NAME, WORDS)                                                                                   \
     DEFINE_UINT_BITAND(NAME, WORDS)                                                                                    \
     DEFINE_UINT_BITOR(NAME, WORDS)                                                                                     \
     DEFINE_UINT_BITXOR(NAME, WORDS)                                                                                    \
     DEFINE_UINT_BITNOT(NAME, WORDS)                                                                                    \
     DEFINE_UINT_SHL(NAME, WORDS)                                                                                       \
     DEFINE_UINT_SHR(NAME, WORDS)                                                                                       \
-    DEFINE_UINT_BITS(NAME, WORDS)                                                                                      \
-    DEFINE_UINT_DIV_MOD(NAME, WORDS)                                                                                   \
-    DEFINE_UINT_DIV(NAME, WORDS)                                                                                       \
-    DEFINE_UINT_MOD(NAME, WORDS)                                                                                       \
-    DEFINE_UINT_IS_EVEN(NAME, WORDS)                                                                                   \
     DEFINE_UINT_OVERFLOW_POW(NAME, WORDS)                                                                              \
     DEFINE_UINT_OVERFLOW_POW_MOD(NAME, WORDS)                                                                          \
+    DEFINE_UINT_FROM_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                     \
+    DEFINE_UINT_FROM_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                                  \
+    DEFINE_UINT_GET_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                      \
+    DEFINE_UINT_GET_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                                   \
+    DEFINE_UINT_READ_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                     \
+    DEFINE_UINT_WRITE_BYTES_BIG_ENDIAN(NAME, WORDS)                                                                    \
+    DEFINE_UINT_READ_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                                  \
+    DEFINE_UINT_WRITE_BYTES_LITTLE_ENDIAN(NAME, WORDS)                                                                 \
+    DEFINE_UINT_FROM_HEX(NAME, WORDS)                                                                                  \
+    DEFINE_UINT_WRITE_HEX(NAME, WORDS)                                                                                 \
     DEFINE_UINT_FROM_DEC_STRING(NAME, WORDS)                                                                           \
     DEFINE_UINT_TO_STRING(NAME, WORDS)                                                                                 \
+    DEFINE_UINT_RAW_PRINTLN(NAME, WORDS)                                                                               \
+    DEFINE_UINT_RAW_PRINT(NAME, WORDS)                                                                                 \
     DEFINE_UINT_PRINT(NAME, WORDS)                                                                                     \
     DEFINE_UINT_PRINTLN(NAME, WORDS)
 
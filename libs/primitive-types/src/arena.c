@@ -0,0 +1,89 @@
+#include <arena.h>
+#include <string.h>
+
+// capacity of the first block of the default arenas, enough for the temporaries of a few 4096 bits operations
+#define SCRATCH_INITIAL_LIMBS 4096
+
+// c99 has no thread local storage class, older standards fall back on the gcc and clang extension
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define THREAD_LOCAL _Thread_local
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+static THREAD_LOCAL BigUintArena scratch = {.current = NULL};
+
+static BigUintArenaBlock *block_new(size_t capacity, BigUintArenaBlock *prev) {
+    BigUintArenaBlock *block = malloc(sizeof(BigUintArenaBlock) + capacity * sizeof(uint64_t));
+    block->prev = prev;
+    block->next = NULL;
+    block->capacity = capacity;
+    block->top = 0;
+    return block;
+}
+
+void biguint_arena_init(BigUintArena *arena, size_t limbs) { arena->current = block_new(limbs, NULL); }
+
+void biguint_arena_free(BigUintArena *arena) {
+    if (arena->current == NULL)
+        return;
+
+    BigUintArenaBlock *block = arena->current;
+    while (block->prev != NULL)
+        block = block->prev;
+    while (block != NULL) {
+        BigUintArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->current = NULL;
+}
+
+uint64_t *biguint_arena_alloc(BigUintArena *arena, size_t limbs) {
+    BigUintArenaBlock *block = arena->current;
+    if (block->top + limbs <= block->capacity) {
+        uint64_t *ptr = block->limbs + block->top;
+        block->top += limbs;
+        return ptr;
+    }
+
+    // the following block is reused when big enough, otherwise it and the ones after it are replaced by a larger one
+    BigUintArenaBlock *next = block->next;
+    if (next == NULL || next->capacity < limbs) {
+        while (next != NULL) {
+            BigUintArenaBlock *after = next->next;
+            free(next);
+            next = after;
+        }
+        size_t capacity = block->capacity * 2;
+        next = block_new(capacity < limbs ? limbs : capacity, block);
+        block->next = next;
+    }
+
+    next->top = limbs;
+    arena->current = next;
+    return next->limbs;
+}
+
+BigUint biguint_arena_new(BigUintArena *arena, int size) {
+    BigUint a = {.size = size, .limbs = biguint_arena_alloc(arena, size)};
+    memset(a.limbs, 0, size * sizeof(uint64_t));
+    return a;
+}
+
+BigUintArenaMark biguint_arena_mark(BigUintArena *arena) {
+    return (BigUintArenaMark){.block = arena->current, .top = arena->current->top};
+}
+
+void biguint_arena_reset(BigUintArena *arena, BigUintArenaMark mark) {
+    arena->current = mark.block;
+    arena->current->top = mark.top;
+}
+
+BigUintArena *biguint_scratch() {
+    if (scratch.current == NULL)
+        biguint_arena_init(&scratch, SCRATCH_INITIAL_LIMBS);
+    return &scratch;
+}
+
+void biguint_scratch_free() { biguint_arena_free(&scratch); }
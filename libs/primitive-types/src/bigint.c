@@ -0,0 +1,67 @@
+#include <bigint.h>
+
+// zero is kept positive, so equal values always compare equal
+static void normalize_sign(BigInt *a) {
+    if (biguint_is_zero(a->mag))
+        a->sign = 1;
+}
+
+void bigint_from_biguint(BigUint a, BigInt *out) {
+    biguint_cpy(&out->mag, a);
+    out->sign = 1;
+}
+
+void bigint_cpy(BigInt *dst, BigInt src) {
+    biguint_cpy(&dst->mag, src.mag);
+    dst->sign = src.sign;
+    normalize_sign(dst);
+}
+
+int bigint_is_zero(BigInt a) { return biguint_is_zero(a.mag); }
+
+int bigint_cmp(BigInt a, BigInt b) {
+    int a_sign = bigint_is_zero(a) ? 1 : a.sign;
+    int b_sign = bigint_is_zero(b) ? 1 : b.sign;
+    if (a_sign != b_sign)
+        return a_sign < b_sign ? -1 : 1;
+    return biguint_cmp(a.mag, b.mag) * a_sign;
+}
+
+void bigint_neg(BigInt a, BigInt *out) {
+    biguint_cpy(&out->mag, a.mag);
+    out->sign = -a.sign;
+    normalize_sign(out);
+}
+
+void bigint_add(BigInt a, BigInt b, BigInt *out) {
+    // the signs are read before out is written, as it may be one of the operands
+    if (a.sign == b.sign) {
+        biguint_add(a.mag, b.mag, &out->mag);
+        out->sign = a.sign;
+    } else if (biguint_cmp(a.mag, b.mag) >= 0) {
+        biguint_sub(a.mag, b.mag, &out->mag);
+        out->sign = a.sign;
+    } else {
+        biguint_sub(b.mag, a.mag, &out->mag);
+        out->sign = b.sign;
+    }
+    normalize_sign(out);
+}
+
+void bigint_sub(BigInt a, BigInt b, BigInt *out) {
+    b.sign = -b.sign;
+    bigint_add(a, b, out);
+}
+
+void bigint_mul(BigInt a, BigInt b, BigInt *out) {
+    int sign = a.sign * b.sign;
+    biguint_mul(a.mag, b.mag, &out->mag);
+    out->sign = sign;
+    normalize_sign(out);
+}
+
+void bigint_mod(BigInt a, BigUint m, BigUint *out) {
+    biguint_mod(a.mag, m, out);
+    if (a.sign < 0 && !biguint_is_zero(*out))
+        biguint_sub(m, *out, out);
+}
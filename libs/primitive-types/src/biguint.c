@@ -1,7 +1,13 @@
+#include <arena.h>
 #include <assert.h>
 #include <biguint.h>
+#include <pthread.h>
 #include <string.h>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
 int get_min_size(BigUint a, BigUint b) {
     if (a.size < b.size)
         return a.size;
@@ -23,6 +29,24 @@ int get_min_size_three(BigUint a, BigUint b, BigUint c) {
     return limit;
 }
 
+int biguint_len(BigUint a) {
+    int len = a.size;
+    while (len > 0 && a.limbs[len - 1] == 0)
+        len--;
+    return len;
+}
+
+// copies the first n limbs of a into dst, filling with zeros if `a` has less limbs
+static void load_limbs(BigUint a, int n, uint64_t *dst) {
+    for (int i = 0; i < n; i++)
+        dst[i] = i < a.size ? a.limbs[i] : 0;
+}
+
+static void store_limbs(const uint64_t *src, int n, BigUint *out) {
+    for (int i = 0; i < out->size; i++)
+        out->limbs[i] = i < n ? src[i] : 0;
+}
+
 void biguint_free_limbs(BigUint *a) {
     if (!a)
         return;
@@ -60,24 +84,6 @@ void biguint_cpy(BigUint *dst, BigUint src) {
     }
 }
 
-void biguint_from_dec_string(char *str, BigUint *out) {
-    biguint_zero(out);
-
-    BigUint ten = biguint_new_heap(out->size);
-    biguint_from_u64(10, &ten);
-    BigUint digit_big = biguint_new_heap(out->size);
-
-    int len = strlen(str);
-    for (int i = 0; i < len; i++) {
-        uint64_t digit = str[i] - '0';
-        biguint_from_u64(digit, &digit_big);
-        biguint_mul(*out, ten, out);
-        biguint_add(*out, digit_big, out);
-    }
-
-    biguint_free(&ten, &digit_big);
-};
-
 void biguint_from_bytes_big_endian(uint8_t *bytes, BigUint *out) {
     biguint_zero(out);
     for (int i = out->size - 1, j = 0; i >= 0; i--, j++) {
@@ -124,56 +130,506 @@ void biguint_get_bytes_little_endian(BigUint value, uint8_t *buffer) {
     }
 };
 
-char *biguint_to_dec_string(BigUint a) {
-    char *result = malloc(a.size * 20 + 1); /* multiply by 20, since each part can
-                                                 take as much as 20 bytes*/
-    int i = a.size * 20 - 1;
-    BigUint ten = biguint_new_heap(a.size);
-    biguint_from_u64(10, &ten);
+static uint64_t load_u64_big_endian(const uint8_t *bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++)
+        v = (v << 8) | bytes[i];
+    return v;
+}
 
-    BigUint dividend = biguint_new_heap(a.size);
-    biguint_cpy(&dividend, a);
-    BigUint quot = biguint_new_heap(dividend.size);
-    BigUint rem = biguint_new_heap(dividend.size);
+static void store_u64_big_endian(uint64_t v, uint8_t *bytes) {
+    for (int i = 7; i >= 0; i--, v >>= 8)
+        bytes[i] = v & 0xFF;
+}
 
-    while (1) {
-        biguint_divmod(dividend, ten, &quot, &rem);
-        int digit = rem.limbs[0] + '0';
-        result[i] = digit;
-        biguint_cpy(&dividend, quot);
-        if (biguint_is_zero(dividend))
-            break;
-        i -= 1;
+static uint64_t load_u64_little_endian(const uint8_t *bytes) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--)
+        v = (v << 8) | bytes[i];
+    return v;
+}
+
+static void store_u64_little_endian(uint64_t v, uint8_t *bytes) {
+    for (int i = 0; i < 8; i++, v >>= 8)
+        bytes[i] = v & 0xFF;
+}
+
+// whether value fits in len bytes
+static int fits_bytes(BigUint value, int len) { return len >= 0 && biguint_bits(value) <= (long long)len * 8; }
+
+int biguint_read_bytes_big_endian(const uint8_t *bytes, int len, BigUint *out) {
+    biguint_zero(out);
+    // leading zeros do not count towards the length
+    while (len > 0 && *bytes == 0) {
+        bytes++;
+        len--;
+    }
+    if (len > out->size * 8)
+        return -1;
+
+    int limb = 0;
+    for (; len >= 8; len -= 8)
+        out->limbs[limb++] = load_u64_big_endian(bytes + len - 8);
+    uint64_t top = 0;
+    for (int i = 0; i < len; i++)
+        top = (top << 8) | bytes[i];
+    if (len > 0)
+        out->limbs[limb] = top;
+    return 0;
+}
+
+int biguint_write_bytes_big_endian(BigUint value, uint8_t *buffer, int len) {
+    if (!fits_bytes(value, len))
+        return -1;
+
+    for (int limb = 0; len > 0; limb++) {
+        uint64_t v = limb < value.size ? value.limbs[limb] : 0;
+        if (len >= 8) {
+            store_u64_big_endian(v, buffer + len - 8);
+            len -= 8;
+            continue;
+        }
+        for (; len > 0; len--, v >>= 8)
+            buffer[len - 1] = v & 0xFF;
+    }
+    return 0;
+}
+
+int biguint_read_bytes_little_endian(const uint8_t *bytes, int len, BigUint *out) {
+    biguint_zero(out);
+    // trailing zeros are the most significant ones here
+    while (len > 0 && bytes[len - 1] == 0)
+        len--;
+    if (len > out->size * 8)
+        return -1;
+
+    int limb = 0, i = 0;
+    for (; len - i >= 8; i += 8)
+        out->limbs[limb++] = load_u64_little_endian(bytes + i);
+    uint64_t top = 0;
+    for (int j = len - 1; j >= i; j--)
+        top = (top << 8) | bytes[j];
+    if (i < len)
+        out->limbs[limb] = top;
+    return 0;
+}
+
+int biguint_write_bytes_little_endian(BigUint value, uint8_t *buffer, int len) {
+    if (!fits_bytes(value, len))
+        return -1;
+
+    for (int limb = 0, i = 0; i < len; limb++) {
+        uint64_t v = limb < value.size ? value.limbs[limb] : 0;
+        if (len - i >= 8) {
+            store_u64_little_endian(v, buffer + i);
+            i += 8;
+            continue;
+        }
+        for (; i < len; i++, v >>= 8)
+            buffer[i] = v & 0xFF;
+    }
+    return 0;
+}
+
+/**
+ * Hexadecimal conversion
+ *
+ * Both ways handle 8 digits at a time with SWAR, SIMD within a register: the digits sit one per byte of a 64 bit word,
+ * so classifying, converting and packing them takes a few word wide operations rather than a branch per digit.
+ * Bytes never exceed 0x7F in the intermediate values, so no carry leaks into the next lane.
+ */
+#define SWAR_ONES 0x0101010101010101ULL
+#define SWAR_HIGH 0x8080808080808080ULL
+
+// spreads the 8 nibbles of x over the bytes of a word, the most significant one in the lowest byte, and turns them into
+// lowercase hex digits: every nibble is offset by '0', the ones from 10 up by 39 more to land on 'a'
+static uint64_t hex_encode_u32(uint32_t x) {
+    uint64_t v = x;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    v = __builtin_bswap64(v);
+    uint64_t letters = ((v + SWAR_ONES * 6) >> 4) & SWAR_ONES;
+    return v + SWAR_ONES * '0' + letters * 39;
+}
+
+// writes the 16 hex digits of a limb
+static void hex_encode_limb(uint64_t limb, char *out) {
+    uint64_t high = hex_encode_u32(limb >> 32), low = hex_encode_u32((uint32_t)limb);
+    for (int i = 0; i < 8; i++) {
+        out[i] = (char)(high >> (i * 8));
+        out[i + 8] = (char)(low >> (i * 8));
+    }
+}
+
+// converts 8 hex digits of either case into their value, returns -1 if any of them is not a hex digit
+// a byte x is >= lo when x + (0x80 - lo) has its top bit set, and > hi when x + (0x7F - hi) does
+static int hex_decode_u32(const char *str, uint32_t *out) {
+    uint64_t c = 0;
+    for (int i = 0; i < 8; i++)
+        c |= (uint64_t)(unsigned char)str[i] << (i * 8);
+    if (c & SWAR_HIGH)
+        return -1;
+
+    uint64_t lower = c | SWAR_ONES * 0x20;
+    uint64_t digits = (c + SWAR_ONES * (0x80 - '0')) & ~(c + SWAR_ONES * (0x7F - '9')) & SWAR_HIGH;
+    uint64_t letters = (lower + SWAR_ONES * (0x80 - 'a')) & ~(lower + SWAR_ONES * (0x7F - 'f')) & SWAR_HIGH;
+    if ((digits | letters) != SWAR_HIGH)
+        return -1;
+
+    // '0'..'9' keep their low nibble, 'a'..'f' and 'A'..'F' have 1..6 there
+    uint64_t v = (c & SWAR_ONES * 0x0F) + (letters >> 7) * 9;
+    v = __builtin_bswap64(v);
+    v = (v | (v >> 4)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v >> 8)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v >> 16)) & 0x00000000FFFFFFFFULL;
+    *out = (uint32_t)v;
+    return 0;
+}
+
+static int hex_digit(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f')
+        return (c | 0x20) - 'a' + 10;
+    return -1;
+}
+
+int biguint_from_hex(const char *str, int len, BigUint *out) {
+    biguint_zero(out);
+    if (len >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+        str += 2;
+        len -= 2;
+    }
+    if (len <= 0)
+        return -1;
+    while (len > 1 && *str == '0') {
+        str++;
+        len--;
+    }
+    if (len > out->size * 16)
+        return -1;
+
+    int limb = 0;
+    for (; len >= 16; len -= 16) {
+        uint32_t high, low;
+        if (hex_decode_u32(str + len - 16, &high) < 0 || hex_decode_u32(str + len - 8, &low) < 0) {
+            biguint_zero(out);
+            return -1;
+        }
+        out->limbs[limb++] = ((uint64_t)high << 32) | low;
+    }
+
+    uint64_t top = 0;
+    for (int i = 0; i < len; i++) {
+        int digit = hex_digit(str[i]);
+        if (digit < 0) {
+            biguint_zero(out);
+            return -1;
+        }
+        top = (top << 4) | (uint64_t)digit;
+    }
+    if (len > 0)
+        out->limbs[limb] = top;
+    return 0;
+}
+
+int biguint_hex_size(BigUint a) {
+    int bits = biguint_bits(a);
+    return bits ? (bits + 3) / 4 + 1 : 2;
+}
+
+int biguint_write_hex(BigUint a, char *buffer, int size) {
+    int n = biguint_len(a);
+    int digits = n ? (biguint_bits(a) + 3) / 4 : 1;
+    if (digits + 1 > size)
+        return -1;
+    if (n == 0) {
+        buffer[0] = '0';
+        buffer[1] = '\0';
+        return 1;
+    }
+
+    // the top limb goes without its leading zeros
+    char top[16];
+    hex_encode_limb(a.limbs[n - 1], top);
+    int top_digits = digits - (n - 1) * 16;
+    memcpy(buffer, top + 16 - top_digits, top_digits);
+
+    char *next = buffer + top_digits;
+    for (int i = n - 2; i >= 0; i--, next += 16)
+        hex_encode_limb(a.limbs[i], next);
+    *next = '\0';
+    return digits;
+}
+
+/**
+ * Decimal conversion
+ *
+ * Digits are handled 19 at a time, 10^19 being the largest power of 10 fitting in a limb: parsing folds each chunk in
+ * with a single limb multiply-add, writing divides by it with a single limb divisor. Long inputs are split in halves by
+ * the powers 10^(19 * 2^k), recursively: parsing multiplies the high half back, writing divides it out, so most of the
+ * work runs on balanced operands rather than on passes over the whole number for every 19 digits.
+ */
+#define DEC_CHUNK 10000000000000000000ULL
+#define DEC_CHUNK_DIGITS 19
+#define DEC_SPLIT_THRESHOLD 32
+#define DEC_PARSE_SPLIT_DIGITS 4864
+#define DEC_MAX_LEVELS 32
+
+static uint64_t divmod_u64_limbs(const uint64_t *a, int an, uint64_t d, uint64_t *quot);
+static void divmod_limbs(const uint64_t *a, int an, const uint64_t *b, int bn, uint64_t *quot, uint64_t *rem);
+static uint64_t add_limbs(uint64_t *a, int an, const uint64_t *b, int n);
+static int mul_full_scratch_size(int bn);
+static void mul_full_limbs(const uint64_t *a, int an, const uint64_t *b, int bn, uint64_t *out, uint64_t *scratch);
+
+static int limbs_len(const uint64_t *a, int n) {
+    while (n > 0 && a[n - 1] == 0)
+        n--;
+    return n;
+}
+
+// returns the square of a power of 10^19, trimmed to its significant limbs
+static BigUint dec_power_square(BigUint power, BigUintArena *arena) {
+    BigUint square = biguint_arena_new(arena, power.size * 2);
+    biguint_sqr(power, &square);
+    square.size = biguint_len(square);
+    return square;
+}
+
+// x = x * b + c over the n limbs of x, returns the carry limb
+static uint64_t mul_1_add(uint64_t *x, int n, uint64_t b, uint64_t c) {
+    for (int i = 0; i < n; i++) {
+        __uint128_t p = (__uint128_t)x[i] * b + c;
+        x[i] = (uint64_t)p;
+        c = (uint64_t)(p >> 64);
+    }
+    return c;
+}
+
+// parses the len digits of str, 19 at a time, into out, which has room for `capacity` limbs
+// returns the number of significant limbs, or -1 when the value does not fit
+static int read_dec_basecase(const char *str, int len, uint64_t *out, int capacity) {
+    int n = 0;
+    int first = len % DEC_CHUNK_DIGITS ? len % DEC_CHUNK_DIGITS : DEC_CHUNK_DIGITS;
+    for (int i = 0, chunk_len = first; i < len; i += chunk_len, chunk_len = DEC_CHUNK_DIGITS) {
+        uint64_t chunk = 0;
+        for (int j = i; j < i + chunk_len; j++)
+            chunk = chunk * 10 + (uint64_t)(str[j] - '0');
+
+        uint64_t carry = mul_1_add(out, n, DEC_CHUNK, chunk);
+        if (carry) {
+            if (n == capacity)
+                return -1;
+            out[n++] = carry;
+        }
+    }
+    return n;
+}
+
+// parses the len digits of str into out, which has room for len / 19 + 1 limbs, and returns the number of significant
+// limbs. Long strings are read as high * 10^(19 * 2^k) + low, with the largest such power below len digits
+static int read_dec_limbs(const char *str, int len, const BigUint *powers, uint64_t *out) {
+    int capacity = len / DEC_CHUNK_DIGITS + 1;
+    if (len <= DEC_PARSE_SPLIT_DIGITS)
+        return read_dec_basecase(str, len, out, capacity);
+
+    int level = 0;
+    while (DEC_CHUNK_DIGITS << (level + 1) < len)
+        level++;
+    BigUint power = powers[level];
+    int low_len = DEC_CHUNK_DIGITS << level;
+    int high_len = len - low_len;
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+
+    uint64_t *high = biguint_arena_alloc(arena, high_len / DEC_CHUNK_DIGITS + 1);
+    uint64_t *low = biguint_arena_alloc(arena, low_len / DEC_CHUNK_DIGITS + 1);
+    int hn = read_dec_limbs(str, high_len, powers, high);
+    int ln = read_dec_limbs(str + high_len, low_len, powers, low);
+
+    for (int i = 0; i < capacity; i++)
+        out[i] = 0;
+    if (hn > 0) {
+        uint64_t *product = biguint_arena_alloc(arena, hn + power.size);
+        uint64_t *scratch = biguint_arena_alloc(arena, mul_full_scratch_size(hn < power.size ? hn : power.size));
+        mul_full_limbs(high, hn, power.limbs, power.size, product, scratch);
+        memcpy(out, product, (hn + power.size < capacity ? hn + power.size : capacity) * sizeof(uint64_t));
+    }
+    add_limbs(out, capacity, low, ln);
+
+    biguint_arena_reset(arena, mark);
+    return limbs_len(out, capacity);
+}
+
+int biguint_from_dec(const char *str, int len, BigUint *out) {
+    biguint_zero(out);
+    if (len <= 0)
+        return -1;
+    for (int i = 0; i < len; i++) {
+        if ((unsigned char)(str[i] - '0') > 9)
+            return -1;
+    }
+    while (len > 1 && *str == '0') {
+        str++;
+        len--;
+    }
+
+    // the value is at least 10^(len - 1), 3321 / 1000 being slightly below log2(10)
+    if ((long long)(len - 1) * 3321 / 1000 >= (long long)out->size * 64)
+        return -1;
+
+    if (len <= DEC_PARSE_SPLIT_DIGITS) {
+        if (read_dec_basecase(str, len, out->limbs, out->size) < 0) {
+            biguint_zero(out);
+            return -1;
+        }
+        return 0;
+    }
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+
+    // powers[k] = 10^(19 * 2^k), up to the largest one the string gets split by
+    BigUint powers[DEC_MAX_LEVELS];
+    powers[0] = biguint_arena_new(arena, 1);
+    powers[0].limbs[0] = DEC_CHUNK;
+    for (int level = 0; DEC_CHUNK_DIGITS << (level + 1) < len; level++)
+        powers[level + 1] = dec_power_square(powers[level], arena);
+
+    uint64_t *limbs = biguint_arena_alloc(arena, len / DEC_CHUNK_DIGITS + 1);
+    int n = read_dec_limbs(str, len, powers, limbs);
+    int fits = n <= out->size;
+    if (fits)
+        memcpy(out->limbs, limbs, n * sizeof(uint64_t));
+
+    biguint_arena_reset(arena, mark);
+    return fits ? 0 : -1;
+}
+
+int biguint_from_dec_string(char *str, BigUint *out) { return biguint_from_dec(str, strlen(str), out); }
+
+// writes the n limbs of x as exactly `digits` decimal digits, zero padded, ending right before end
+// x is overwritten in the process
+static void write_dec_basecase(uint64_t *x, int n, int digits, char *end) {
+    while (digits > 0) {
+        if (n == 0) {
+            memset(end - digits, '0', digits);
+            return;
+        }
+        uint64_t chunk = divmod_u64_limbs(x, n, DEC_CHUNK, x);
+        n = limbs_len(x, n);
+        for (int i = 0; i < DEC_CHUNK_DIGITS && digits > 0; i++, digits--) {
+            *--end = '0' + chunk % 10;
+            chunk /= 10;
+        }
+    }
+}
+
+// writes the n limbs of x, which is below powers[level] = 10^(19 * 2^level), as exactly 19 * 2^level decimal digits
+// ending right before end
+static void write_dec_limbs(const uint64_t *x, int n, const BigUint *powers, int level, char *end) {
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+
+    if (level == 0 || n <= DEC_SPLIT_THRESHOLD) {
+        uint64_t *tmp = biguint_arena_alloc(arena, n);
+        memcpy(tmp, x, n * sizeof(uint64_t));
+        write_dec_basecase(tmp, n, DEC_CHUNK_DIGITS << level, end);
+        biguint_arena_reset(arena, mark);
+        return;
+    }
+
+    // x = high * 10^half + low, both halves written as half digits
+    BigUint power = powers[level - 1];
+    int half = DEC_CHUNK_DIGITS << (level - 1);
+    if (n < power.size) {
+        memset(end - half * 2, '0', half);
+        write_dec_limbs(x, n, powers, level - 1, end);
+        return;
+    }
+
+    uint64_t *high = biguint_arena_alloc(arena, n - power.size + 1);
+    uint64_t *low = biguint_arena_alloc(arena, power.size);
+    divmod_limbs(x, n, power.limbs, power.size, high, low);
+    write_dec_limbs(high, limbs_len(high, n - power.size + 1), powers, level - 1, end - half);
+    write_dec_limbs(low, limbs_len(low, power.size), powers, level - 1, end);
+
+    biguint_arena_reset(arena, mark);
+}
+
+int biguint_dec_size(BigUint a) {
+    // 1234 / 4096 is slightly above log10(2)
+    return (int)((long long)biguint_bits(a) * 1234 / 4096) + 2;
+}
+
+int biguint_write_dec(BigUint a, char *buffer, int size) {
+    int n = biguint_len(a);
+    if (n == 0) {
+        if (size < 2)
+            return -1;
+        buffer[0] = '0';
+        buffer[1] = '\0';
+        return 1;
+    }
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+
+    // powers[k] = 10^(19 * 2^k), trimmed to their significant limbs, up to the first one above a
+    BigUint powers[DEC_MAX_LEVELS];
+    powers[0] = biguint_arena_new(arena, 1);
+    powers[0].limbs[0] = DEC_CHUNK;
+    int level = 0;
+    while (biguint_cmp(a, powers[level]) >= 0) {
+        powers[level + 1] = dec_power_square(powers[level], arena);
+        level++;
     }
 
-    char *dst = malloc(a.size * 20 + 1 - i);
-    int k = 0;
-    for (int j = i; j < a.size * 20 + 1; j++) {
-        dst[k] = result[i + k];
-        k++;
+    int digits = DEC_CHUNK_DIGITS << level;
+    char *padded = (char *)biguint_arena_alloc(arena, digits / sizeof(uint64_t) + 1);
+    write_dec_limbs(a.limbs, n, powers, level, padded + digits);
+
+    int skip = 0;
+    while (padded[skip] == '0')
+        skip++;
+    int len = digits - skip;
+    if (len + 1 > size) {
+        biguint_arena_reset(arena, mark);
+        return -1;
     }
-    dst[k - 1] = '\0';
+    memcpy(buffer, padded + skip, len);
+    buffer[len] = '\0';
+
+    biguint_arena_reset(arena, mark);
+    return len;
+}
 
-    biguint_free(&ten, &dividend, &quot, &rem);
-    free(result);
-    return dst;
+char *biguint_to_dec_string(BigUint a) {
+    int size = biguint_dec_size(a);
+    char *result = malloc(size);
+    biguint_write_dec(a, result, size);
+    return result;
 };
 
 /**
  * Utils
  */
 int biguint_bits(BigUint a) {
-    for (int i = 1; i < a.size; i++) {
-        if (a.limbs[a.size - i] > 0) {
-            return 64 * (a.size - i + 1) - u64_leading_zeros(a.limbs[a.size - i]);
-        }
-    }
-    return 64 - u64_leading_zeros(a.limbs[0]);
+    int len = biguint_len(a);
+    if (len == 0)
+        return 0;
+    return 64 * len - u64_leading_zeros(a.limbs[len - 1]);
 }
 
+// values with a different amount of significant limbs are told apart by that alone, otherwise only their significant
+// limbs are compared
 int biguint_cmp(BigUint a, BigUint b) {
-    int limit = get_min_size(a, b);
-    for (int i = limit - 1; i >= 0; i--) {
+    int an = biguint_len(a), bn = biguint_len(b);
+    if (an != bn)
+        return an < bn ? -1 : 1;
+    for (int i = an - 1; i >= 0; i--) {
         uint64_t a_i = a.limbs[i];
         uint64_t b_i = b.limbs[i];
         if (a_i < b_i)
@@ -184,28 +640,33 @@ int biguint_cmp(BigUint a, BigUint b) {
     return 0;
 }
 
-int biguint_is_zero(BigUint a) {
-    for (int i = 0; i < a.size; i++) {
-        if (a.limbs[i] != 0)
-            return 0;
-    }
-    return 1;
-};
+int biguint_is_zero(BigUint a) { return biguint_len(a) == 0; };
 
 /**
  * Operations
  */
+// only the significant limbs of the operands are added, the rest of out is just filled with the final carry
 int biguint_overflow_add(BigUint a, BigUint b, BigUint *out) {
+    int an = biguint_len(a), bn = biguint_len(b), n = out->size;
+    int limit = an > bn ? an : bn;
     uint64_t carry = 0;
-    int limit = get_min_size_three(a, b, *out);
+    int overflow = 0;
 
     for (int i = 0; i < limit; i++) {
-        u64_overflow_op addition = u64_overflow_add(a.limbs[i], b.limbs[i]);
-        u64_overflow_op carry_addition = u64_overflow_add(addition.res, carry);
-        out->limbs[i] = carry_addition.res;
-        carry = addition.overflow + carry_addition.overflow;
+        uint64_t sum = u64_addc(i < an ? a.limbs[i] : 0, i < bn ? b.limbs[i] : 0, carry, &carry);
+        if (i < n)
+            out->limbs[i] = sum;
+        else
+            overflow |= sum != 0;
     }
-    return carry > 0;
+
+    if (limit < n)
+        out->limbs[limit] = carry;
+    else
+        overflow |= carry > 0;
+    for (int i = limit + 1; i < n; i++)
+        out->limbs[i] = 0;
+    return overflow;
 };
 
 void biguint_add(BigUint a, BigUint b, BigUint *out) { biguint_overflow_add(a, b, out); }
@@ -215,17 +676,24 @@ void biguint_add_mod(BigUint a, BigUint b, BigUint m, BigUint *out) {
     biguint_mod(*out, m, out);
 }
 
+// only the significant limbs of the operands are subtracted, the rest of out is just filled with the final borrow
 int biguint_overflow_sub(BigUint a, BigUint b, BigUint *out) {
+    int an = biguint_len(a), bn = biguint_len(b), n = out->size;
+    int limit = an > bn ? an : bn;
     uint64_t carry = 0;
-    int limit = get_min_size_three(a, b, *out);
+    int overflow = 0;
 
     for (int i = 0; i < limit; i++) {
-        u64_overflow_op sub = u64_overflow_sub(a.limbs[i], b.limbs[i]);
-        u64_overflow_op carry_sub = u64_overflow_sub(sub.res, carry);
-        out->limbs[i] = carry_sub.res;
-        carry = sub.overflow + carry_sub.overflow;
+        uint64_t diff = u64_subb(i < an ? a.limbs[i] : 0, i < bn ? b.limbs[i] : 0, carry, &carry);
+        if (i < n)
+            out->limbs[i] = diff;
+        else
+            overflow |= diff != 0;
     }
-    return carry > 0;
+
+    for (int i = limit; i < n; i++)
+        out->limbs[i] = carry ? UINT64_MAX : 0;
+    return overflow | (carry > 0);
 };
 
 void biguint_sub(BigUint a, BigUint b, BigUint *out) { biguint_overflow_sub(a, b, out); }
@@ -235,255 +703,1915 @@ void biguint_sub_mod(BigUint a, BigUint b, BigUint m, BigUint *out) {
     biguint_mod(*out, m, out);
 }
 
-int biguint_overflow_mul(BigUint a, BigUint b, BigUint *out) {
-    int limit = get_min_size_three(a, b, *out);
-    uint64_t result[limit * 2];
-    for (int i = 0; i < limit * 2; i++)
-        result[i] = 0;
-    for (int i = 0; i < limit; i++) {
-        uint64_t carry = 0;
-        for (int j = 0; j < limit; j++) { /* calculate result */
-            u64_mul_op mul = u64_mul(a.limbs[j], b.limbs[i]);
-            uint64_t current = result[i + j];
-            u64_overflow_op addition = u64_overflow_add(mul.res, current);
-            result[i + j] = addition.res; /* calculate carry */
-            uint64_t carry_current = result[i + j + 1];
-            u64_overflow_op carry_addition = u64_overflow_add(mul.carry + addition.overflow, carry);
-            u64_overflow_op current_carry_addition = u64_overflow_add(carry_addition.res, carry_current);
-            result[i + j + 1] = current_carry_addition.res;
-            carry = carry_addition.overflow | current_carry_addition.overflow;
-        }
-    }
-    int overflow = 0;
-    if (out->size < limit * 2) {
-        for (int i = 4; i < limit * 2 && out->size < limit * 2; i++) {
-            if (result[i] != 0) {
-                overflow = 1;
-                break;
-            }
-        }
+/**
+ * Limb kernels
+ *
+ * Every schoolbook row, squaring row and montgomery reduction step boils down to out += a * b for a single limb b.
+ * That kernel is picked once at load time: x86-64 CPUs with BMI2 and ADX get an assembly version built on mulx, which
+ * doesn't touch the flags, and on adcx/adox, which carry through CF and OF respectively so the low and high halves of
+ * the products are accumulated in two independent chains.
+ */
+typedef uint64_t (*AddMulFn)(uint64_t *out, const uint64_t *a, int n, uint64_t b);
+
+// adds a * b to the n limbs of out and returns the carry limb
+static uint64_t addmul_1_portable(uint64_t *out, const uint64_t *a, int n, uint64_t b) {
+    uint64_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        __uint128_t r = (__uint128_t)a[i] * b + out[i] + carry;
+        out[i] = (uint64_t)r;
+        carry = (uint64_t)(r >> 64);
     }
-    for (int i = 0; i < out->size; i++)
-        out->limbs[i] = result[i];
+    return carry;
+}
 
-    return overflow;
-};
+#if defined(__x86_64__) && defined(__GNUC__)
+// same as addmul_1_portable, n must be at least 1
+// the index runs from -n up to 0 so the loop is driven by lea and jrcxz, neither of them touches CF or OF
+static uint64_t addmul_1_adx(uint64_t *out, const uint64_t *a, int n, uint64_t b) {
+    uint64_t carry, lo, hi;
+    int64_t i = -(int64_t)n;
+    __asm__ volatile("xorl %k[carry], %k[carry]\n\t" // also clears CF and OF
+                     "1:\n\t"
+                     "mulx (%[a],%[i],8), %[lo], %[hi]\n\t"
+                     "adcx %[carry], %[lo]\n\t"
+                     "adox (%[out],%[i],8), %[lo]\n\t"
+                     "movq %[lo], (%[out],%[i],8)\n\t"
+                     "movq %[hi], %[carry]\n\t"
+                     "leaq 1(%[i]), %[i]\n\t"
+                     "jrcxz 2f\n\t"
+                     "jmp 1b\n\t"
+                     "2:\n\t"
+                     "movl $0, %k[lo]\n\t"
+                     "adcx %[lo], %[carry]\n\t"
+                     "adox %[lo], %[carry]\n\t"
+                     : [carry] "=&r"(carry), [lo] "=&r"(lo), [hi] "=&r"(hi), [i] "+c"(i)
+                     : [a] "r"(a + n), [out] "r"(out + n), "d"(b)
+                     : "cc", "memory");
+    return carry;
+}
 
-void biguint_mul(BigUint a, BigUint b, BigUint *out) { biguint_overflow_mul(a, b, out); }
+static int asm_kernels_supported() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return 0;
+    return (ebx & bit_BMI2) && (ebx & bit_ADX);
+}
+#else
+static uint64_t addmul_1_adx(uint64_t *out, const uint64_t *a, int n, uint64_t b) {
+    return addmul_1_portable(out, a, n, b);
+}
 
-void biguint_mul_mod(BigUint a, BigUint b, BigUint m, BigUint *out) {
-    int limit = get_min_size_three(a, b, *out);
-    // allocate twice the memory to prevent overflow
-    BigUint result = biguint_new_heap(limit * 2);
-    BigUint mod = biguint_new_heap(limit * 2);
-    biguint_cpy(&mod, m);
+static int asm_kernels_supported() { return 0; }
+#endif
 
-    biguint_mul(a, b, &result);
-    biguint_mod(result, mod, out);
+static AddMulFn addmul_1 = addmul_1_portable;
 
-    biguint_free(&result, &mod);
+__attribute__((constructor)) static void select_kernels() {
+    if (asm_kernels_supported())
+        addmul_1 = addmul_1_adx;
 }
 
-// https://en.wikipedia.org/wiki/Exponentiation_by_squaring
-int biguint_overflow_pow(BigUint a, BigUint exponent, BigUint *out) {
-    if (biguint_is_zero(exponent)) {
-        biguint_one(out);
-        return 0;
-    }
+void biguint_set_asm_kernels(int enabled) {
+    addmul_1 = enabled && asm_kernels_supported() ? addmul_1_adx : addmul_1_portable;
+}
 
-    int overflow = 0;
-    BigUint one = biguint_new_heap(a.size);
-    BigUint exp = biguint_new_heap(exponent.size);
-    BigUint y = biguint_new_heap(a.size);
-    biguint_one(&y);
-    biguint_one(&one);
-    biguint_cpy(&exp, exponent);
-    biguint_cpy(out, a);
-
-    while (biguint_cmp(exp, one) > 0) {
-        if (biguint_is_even(exp)) {
-            overflow |= biguint_overflow_mul(*out, *out, out);
-            biguint_shr(exp, 1, &exp);
-        } else {
-            overflow |= biguint_overflow_mul(y, *out, &y);
-            overflow |= biguint_overflow_mul(*out, *out, out);
-            biguint_sub(exp, one, &exp);
-            biguint_shr(exp, 1, &exp);
-        }
-    }
+int biguint_asm_kernels() { return addmul_1 == addmul_1_adx && asm_kernels_supported(); }
 
-    overflow |= biguint_overflow_mul(*out, y, out);
+// computes the lower `out_len` limbs of a * b, where out_len <= an + bn
+static void mul_limbs(const uint64_t *a, int an, const uint64_t *b, int bn, uint64_t *out, int out_len) {
+    for (int i = 0; i < out_len; i++)
+        out[i] = 0;
 
-    biguint_free(&one, &exp, &y);
-    return overflow;
+    for (int i = 0; i < bn && i < out_len; i++) {
+        int len = an < out_len - i ? an : out_len - i;
+        uint64_t carry = len > 0 ? addmul_1(out + i, a, len, b[i]) : 0;
+        if (i + len < out_len)
+            out[i + len] = carry;
+    }
 }
 
-void biguint_pow(BigUint a, BigUint exponent, BigUint *out) { biguint_overflow_pow(a, exponent, out); }
+// computes the lower `out_len` limbs of the square of a, where out_len <= 2n
+// each cross product a_i * a_j (i != j) is computed once and then doubled, saving almost half of the limb products
+static void sqr_limbs(const uint64_t *a, int n, uint64_t *out, int out_len) {
+    for (int i = 0; i < out_len; i++)
+        out[i] = 0;
+
+    // cross products
+    for (int i = 0; i < n; i++) {
+        // a_i * a_j for j > i lands on out[i + j]
+        int len = n - i - 1 < out_len - i * 2 - 1 ? n - i - 1 : out_len - i * 2 - 1;
+        uint64_t carry = len > 0 ? addmul_1(out + i * 2 + 1, a + i + 1, len, a[i]) : 0;
+        if (i + n < out_len)
+            out[i + n] = carry;
+    }
 
-// performs a pow operation keeping the result in bounds over a mod m, using the following identity:
-// (a ⋅ b) mod m = [(a mod m) ⋅ (b mod m)] mod m
-// https://en.wikipedia.org/wiki/Modular_exponentiation
-void biguint_pow_mod(BigUint a, BigUint exponent, BigUint m, BigUint *out) {
-    if (biguint_is_zero(exponent)) {
-        biguint_one(out);
-        return;
+    // double them
+    uint64_t top = 0;
+    for (int i = 0; i < out_len; i++) {
+        uint64_t next = out[i] >> 63;
+        out[i] = (out[i] << 1) | top;
+        top = next;
     }
 
-    // Since this is the power over a boundary, we want to prevent overflows during multiplication
-    // so we have to allocate twice the memory
-    // in the end we wrap it around the m and it should fit back into the initial size
-    //
-    // note that we could use mul_mod but this way we avoid
-    // allocating and freeing memory on the heap every iteration as mul_mod does it for use
-    BigUint base = biguint_new_heap(a.size * 2);
-    BigUint mod = biguint_new_heap(m.size * 2);
-    BigUint one = biguint_new(1);
-    BigUint exp = biguint_new_heap(exponent.size);
-    BigUint y = biguint_new_heap(a.size * 2);
-    biguint_one(&y);
-    biguint_cpy(&base, a);
-    biguint_cpy(&mod, m);
-    biguint_one(&one);
-    biguint_cpy(&exp, exponent);
-
-    biguint_mod(base, mod, &base);
-    while (biguint_cmp(exp, one) > 0) {
-        if (biguint_is_even(exp)) {
-            biguint_mul(base, base, &base);
-            biguint_mod(base, mod, &base);
-            biguint_shr(exp, 1, &exp);
-        } else {
-            biguint_mul(y, base, &y);
-            biguint_mod(y, mod, &y);
-            biguint_mul(base, base, &base);
-            biguint_mod(base, mod, &base);
-            biguint_sub(exp, one, &exp);
-            biguint_shr(exp, 1, &exp);
+    // add the diagonal a_i * a_i
+    uint64_t carry = 0;
+    for (int i = 0; i < n && i * 2 < out_len; i++) {
+        __uint128_t sq = (__uint128_t)a[i] * a[i];
+        __uint128_t lo = (__uint128_t)out[2 * i] + (uint64_t)sq + carry;
+        out[2 * i] = (uint64_t)lo;
+        if (i * 2 + 1 < out_len) {
+            __uint128_t hi = (__uint128_t)out[2 * i + 1] + (uint64_t)(sq >> 64) + (uint64_t)(lo >> 64);
+            out[2 * i + 1] = (uint64_t)hi;
+            carry = (uint64_t)(hi >> 64);
         }
     }
-
-    biguint_mul(base, y, &base);
-    biguint_mod(base, mod, &base);
-
-    biguint_cpy(out, base);
-
-    biguint_free(&base, &mod, &exp, &y);
 }
 
-void biguint_bitand(BigUint a, BigUint b, BigUint *out) {
-    int limit = get_min_size_three(a, b, *out);
-    for (int i = 0; i < limit; i++)
-        out->limbs[i] = a.limbs[i] & b.limbs[i];
+// adds the n limbs of b into the an limbs of a (an >= n) and returns the carry
+static uint64_t add_limbs(uint64_t *a, int an, const uint64_t *b, int n) {
+    uint64_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        a[i] = u64_addc(a[i], b[i], carry, &carry);
+    }
+    for (int i = n; i < an && carry; i++)
+        carry = ++a[i] == 0;
+    return carry;
 }
 
-void biguint_bitor(BigUint a, BigUint b, BigUint *out) {
-    int limit = get_min_size_three(a, b, *out);
-    for (int i = 0; i < limit; i++)
-        out->limbs[i] = a.limbs[i] | b.limbs[i];
+// subtracts the n limbs of b from the an limbs of a (an >= n) and returns the borrow
+static uint64_t sub_limbs(uint64_t *a, int an, const uint64_t *b, int n) {
+    uint64_t borrow = 0;
+    for (int i = 0; i < n; i++) {
+        a[i] = u64_subb(a[i], b[i], borrow, &borrow);
+    }
+    for (int i = n; i < an && borrow; i++)
+        borrow = a[i]-- == 0;
+    return borrow;
 }
 
-void biguint_bitxor(BigUint a, BigUint b, BigUint *out) {
-    int limit = get_min_size(a, b);
-    for (int i = 0; i < limit; i++)
-        out->limbs[i] = a.limbs[i] ^ b.limbs[i];
-}
+// writes |a - b| into out, where a has an limbs and b has bn limbs (an >= bn), returns 1 if a < b
+static int abs_diff_limbs(const uint64_t *a, int an, const uint64_t *b, int bn, uint64_t *out) {
+    int i = an - 1;
+    while (i >= bn && a[i] == 0)
+        i--;
+    if (i < bn) {
+        while (i >= 0 && a[i] == b[i])
+            i--;
+    }
 
-void biguint_bitnot(BigUint a, BigUint *out) {
-    int limit = get_min_size(a, *out);
-    for (int i = 0; i < limit; i++)
-        out->limbs[i] = ~a.limbs[i];
+    int negative = i >= 0 && i < bn && a[i] < b[i];
+    const uint64_t *x = negative ? b : a, *y = negative ? a : b;
+    for (int j = 0; j < an; j++)
+        out[j] = j < bn ? x[j] : a[j];
+    sub_limbs(out, an, y, bn);
+    return negative;
 }
 
-void biguint_shl(BigUint a, int shift, BigUint *out) {
-    int shift_start = shift / 64;
-    int shift_mod = shift % 64;
-    BigUint cpy = biguint_new_heap(a.size);
-    biguint_cpy(&cpy, a);
-    biguint_zero(out);
-    int limit = get_min_size(a, *out);
+// operands with at least this many limbs are multiplied with Karatsuba instead of schoolbook
+static int karatsuba_threshold = 24;
+
+void biguint_set_karatsuba_threshold(int limbs) { karatsuba_threshold = limbs < 4 ? 4 : limbs; }
 
-    for (int i = shift_start; i < limit; i++) {
-        out->limbs[i] = cpy.limbs[i - shift_start] << shift_mod;
+int biguint_karatsuba_threshold() { return karatsuba_threshold; }
+
+// number of scratch limbs needed by `karatsuba_limbs` for n limbs operands
+static int karatsuba_scratch_size(int n) {
+    int size = 0;
+    while (n >= karatsuba_threshold) {
+        int h = n - n / 2;
+        size += h * 6 + 1;
+        n = h;
     }
+    return size;
+}
 
-    /* calculate carry */
-    if (shift_mod > 0) {
-        for (int i = shift_start + 1; i < limit; i++) {
-            out->limbs[i] += cpy.limbs[i - shift_start - 1] >> (64 - shift_mod);
-        }
+// computes the 2n limbs product of a and b, both of n limbs, when a == b it squares a
+// splitting a = a0 + a1 * b^h, b = b0 + b1 * b^h, the middle term a0 * b1 + a1 * b0 is obtained as
+// a0 * b0 + a1 * b1 - (a0 - a1) * (b0 - b1), hence only three half sized products are needed
+// https://en.wikipedia.org/wiki/Karatsuba_algorithm
+static void karatsuba_limbs(const uint64_t *a, const uint64_t *b, int n, uint64_t *out, uint64_t *scratch) {
+    if (n < karatsuba_threshold) {
+        if (a == b)
+            sqr_limbs(a, n, out, n * 2);
+        else
+            mul_limbs(a, n, b, n, out, n * 2);
+        return;
     }
 
-    biguint_free(&cpy);
-}
+    int l = n / 2, h = n - l;
+    uint64_t *da = scratch, *db = da + h, *mid = db + h, *t = mid + h * 2, *next = t + h * 2 + 1;
 
-void biguint_shr(BigUint a, int shift, BigUint *out) {
-    int shift_start = shift / 64;
-    int shift_mod = shift % 64;
-    BigUint cpy = biguint_new_heap(a.size);
-    biguint_cpy(&cpy, a);
-    biguint_zero(out);
-    int limit = get_min_size(a, *out);
+    karatsuba_limbs(a, a == b ? a : b, h, out, next);
+    karatsuba_limbs(a + h, a == b ? a + h : b + h, l, out + h * 2, next);
 
-    for (int i = shift_start; i < limit; i++) {
-        out->limbs[i - shift_start] = cpy.limbs[i] >> shift_mod;
+    // (a0 - a1) * (b0 - b1) is negative when exactly one of the differences is, a square never is
+    int negative = abs_diff_limbs(a, h, a + h, l, da);
+    if (a == b) {
+        negative = 0;
+        karatsuba_limbs(da, da, h, mid, next);
+    } else {
+        negative ^= abs_diff_limbs(b, h, b + h, l, db);
+        karatsuba_limbs(da, db, h, mid, next);
     }
 
-    /* calculate carry */
-    if (shift_mod > 0) {
-        for (int i = shift_start + 1; i < limit; i++) {
-            out->limbs[i - shift_start - 1] += cpy.limbs[i] << (64 - shift_mod);
-        }
-    }
+    // t = a0 * b0 + a1 * b1 -/+ |a0 - a1| * |b0 - b1|
+    for (int i = 0; i < h * 2; i++)
+        t[i] = out[i];
+    t[h * 2] = 0;
+    add_limbs(t, h * 2 + 1, out + h * 2, l * 2);
+    if (negative)
+        add_limbs(t, h * 2 + 1, mid, h * 2);
+    else
+        sub_limbs(t, h * 2 + 1, mid, h * 2);
 
-    biguint_free(&cpy);
+    int t_len = h * 2 + 1 < n * 2 - h ? h * 2 + 1 : n * 2 - h;
+    add_limbs(out + h, n * 2 - h, t, t_len);
 }
 
-void biguint_divmod(BigUint a, BigUint b, BigUint *quot, BigUint *rem) {
-    int a_bits = biguint_bits(a);
-    int b_bits = biguint_bits(b);
-    biguint_cpy(rem, a);
-    biguint_zero(quot);
+// operands with at least this many limbs are multiplied with Toom-3 instead of Karatsuba
+static int toom3_threshold = 256;
 
-    assert(b_bits != 0);
-    if (a_bits < b_bits) {
-        return;
-    }
+void biguint_set_toom3_threshold(int limbs) { toom3_threshold = limbs < 9 ? 9 : limbs; }
 
-    int shift = a_bits - b_bits;
-    BigUint shift_copy = biguint_new_heap(b.size);
-    biguint_cpy(&shift_copy, b);
-    biguint_shl(shift_copy, shift, &shift_copy);
-    while (1) {
-        /* rem >= shift_copy */
-        if (biguint_cmp(*rem, shift_copy) >= 0) {
-            if (shift / 64 < quot->size) {
-                quot->limbs[shift / 64] |= ((uint64_t)1 << (uint64_t)(shift % 64));
-            }
-            biguint_sub(*rem, shift_copy, rem);
-        }
-        if (shift == 0)
-            break;
-        shift -= 1;
-        biguint_shr(shift_copy, 1, &shift_copy);
-    }
+int biguint_toom3_threshold() { return toom3_threshold; }
 
-    biguint_free(&shift_copy);
-}
+static int mul_n_scratch_size(int n);
+static void mul_n_limbs(const uint64_t *a, const uint64_t *b, int n, uint64_t *out, uint64_t *scratch);
 
-void biguint_div(BigUint a, BigUint b, BigUint *out) {
-    BigUint rem = biguint_new_heap(out->size);
-    biguint_divmod(a, b, out, &rem);
-    biguint_free(&rem);
+// the helpers below treat w limbs as a two's complement signed number, Toom-3 interpolation goes through negative
+// intermediate values
+
+static void tc_neg(uint64_t *x, int w) {
+    uint64_t carry = 1;
+    for (int i = 0; i < w; i++) {
+        x[i] = ~x[i] + carry;
+        carry = carry && x[i] == 0;
+    }
 }
 
-void biguint_mod(BigUint a, BigUint b, BigUint *out) {
-    BigUint quot = biguint_new_heap(out->size);
-    biguint_divmod(a, b, &quot, out);
-    biguint_free(&quot);
+// arithmetic shift right by one bit, x must be even
+static void tc_shr1(uint64_t *x, int w) {
+    for (int i = 0; i < w - 1; i++)
+        x[i] = (x[i] >> 1) | (x[i + 1] << 63);
+    x[w - 1] = (x[w - 1] >> 1) | (x[w - 1] & (1ULL << 63));
+}
+
+// divides x by 3, x must be a multiple of 3
+// since the division is exact, it is a multiplication by the inverse of 3 modulo 2^64 propagated limb by limb
+static void tc_divexact3(uint64_t *x, int w) {
+    const uint64_t inv3 = 0xAAAAAAAAAAAAAAABULL;
+    uint64_t carry = 0;
+    for (int i = 0; i < w; i++) {
+        uint64_t s = x[i] - carry;
+        uint64_t borrow = s > x[i];
+        x[i] = s * inv3;
+        carry = (uint64_t)(((__uint128_t)x[i] * 3) >> 64) + borrow;
+    }
+}
+
+// writes |x| into out and returns 1 if x is negative
+static int tc_abs(const uint64_t *x, int w, uint64_t *out) {
+    for (int i = 0; i < w; i++)
+        out[i] = x[i];
+    int negative = x[w - 1] >> 63;
+    if (negative)
+        tc_neg(out, w);
+    return negative;
+}
+
+// evaluates a0 + a1 * x + a2 * x^2 at x = 1, -1, -2, where a0, a1 have k limbs and a2 has l limbs
+static void toom3_eval(const uint64_t *a, int k, int l, uint64_t *p1, uint64_t *pm1, uint64_t *pm2, int w) {
+    // p1 = a0 + a2
+    for (int i = 0; i < w; i++)
+        p1[i] = i < k ? a[i] : 0;
+    add_limbs(p1, w, a + k * 2, l);
+
+    // pm1 = a0 + a2 - a1, p1 = a0 + a2 + a1
+    for (int i = 0; i < w; i++)
+        pm1[i] = p1[i];
+    sub_limbs(pm1, w, a + k, k);
+    add_limbs(p1, w, a + k, k);
+
+    // pm2 = (pm1 + a2) * 2 - a0
+    for (int i = 0; i < w; i++)
+        pm2[i] = pm1[i];
+    add_limbs(pm2, w, a + k * 2, l);
+    add_limbs(pm2, w, pm2, w);
+    sub_limbs(pm2, w, a, k);
+}
+
+// multiplies the two evaluations pa and pb (w limbs each) into r (rw limbs)
+static void toom3_point_mul(const uint64_t *pa, const uint64_t *pb, int w, uint64_t *r, int rw, uint64_t *scratch) {
+    uint64_t *ma = scratch, *mb = ma + w, *next = mb + w;
+    int negative = tc_abs(pa, w, ma);
+    if (pa == pb) {
+        negative = 0;
+        mb = ma;
+    } else {
+        negative ^= tc_abs(pb, w, mb);
+    }
+
+    // the magnitudes fit in w - 1 limbs
+    mul_n_limbs(ma, mb, w - 1, r, next);
+    for (int i = (w - 1) * 2; i < rw; i++)
+        r[i] = 0;
+    if (negative)
+        tc_neg(r, rw);
+}
+
+// number of scratch limbs used by a single level of `toom3_limbs`, excluding its recursive products
+static int toom3_level_scratch_size(int n) {
+    int k = (n + 2) / 3, w = k + 2, rw = k * 2 + 4;
+    return w * 6 + rw * 5 + w * 2;
+}
+
+// computes the 2n limbs product of a and b, both of n limbs, when a == b it squares a
+// splitting the operands in three parts they are seen as polynomials in x = b^k, which are evaluated at
+// 0, 1, -1, -2 and infinity, multiplied pointwise and interpolated back with Bodrato's sequence, hence five
+// products of a third of the size are needed instead of the nine of schoolbook
+// https://en.wikipedia.org/wiki/Toom%E2%80%93Cook_multiplication
+static void toom3_limbs(const uint64_t *a, const uint64_t *b, int n, uint64_t *out, uint64_t *scratch) {
+    int k = (n + 2) / 3, l = n - k * 2, w = k + 2, rw = k * 2 + 4;
+    int sqr = a == b;
+
+    uint64_t *pa1 = scratch, *pam1 = pa1 + w, *pam2 = pam1 + w;
+    uint64_t *pb1 = pam2 + w, *pbm1 = pb1 + w, *pbm2 = pbm1 + w;
+    uint64_t *r0 = pbm2 + w, *r1 = r0 + rw, *rm1 = r1 + rw, *rm2 = rm1 + rw, *rinf = rm2 + rw, *next = rinf + rw;
+
+    toom3_eval(a, k, l, pa1, pam1, pam2, w);
+    if (sqr) {
+        pb1 = pa1;
+        pbm1 = pam1;
+        pbm2 = pam2;
+    } else {
+        toom3_eval(b, k, l, pb1, pbm1, pbm2, w);
+    }
+
+    // r(0) and r(inf) go straight to their final position
+    mul_n_limbs(a, sqr ? a : b, k, out, next);
+    mul_n_limbs(a + k * 2, sqr ? a + k * 2 : b + k * 2, l, out + k * 4, next);
+    toom3_point_mul(pa1, pb1, w, r1, rw, next);
+    toom3_point_mul(pam1, pbm1, w, rm1, rw, next);
+    toom3_point_mul(pam2, pbm2, w, rm2, rw, next);
+
+    for (int i = 0; i < rw; i++) {
+        r0[i] = i < k * 2 ? out[i] : 0;
+        rinf[i] = i < l * 2 ? out[k * 4 + i] : 0;
+    }
+
+    // r3 = (r(-2) - r(1)) / 3
+    sub_limbs(rm2, rw, r1, rw);
+    tc_divexact3(rm2, rw);
+    // r1 = (r(1) - r(-1)) / 2
+    sub_limbs(r1, rw, rm1, rw);
+    tc_shr1(r1, rw);
+    // r2 = r(-1) - r(0)
+    sub_limbs(rm1, rw, r0, rw);
+    // r3 = (r2 - r3) / 2 + 2 * r(inf)
+    sub_limbs(rm2, rw, rm1, rw);
+    tc_neg(rm2, rw);
+    tc_shr1(rm2, rw);
+    add_limbs(rm2, rw, rinf, rw);
+    add_limbs(rm2, rw, rinf, rw);
+    // r2 = r2 + r1 - r(inf)
+    add_limbs(rm1, rw, r1, rw);
+    sub_limbs(rm1, rw, rinf, rw);
+    // r1 = r1 - r3
+    sub_limbs(r1, rw, rm2, rw);
+
+    // all the coefficients are now non negative, they are added at their position
+    for (int i = k * 2; i < k * 4; i++)
+        out[i] = 0;
+    const uint64_t *coefficients[] = {r1, rm1, rm2};
+    for (int i = 1; i <= 3; i++) {
+        int offset = k * i, len = rw < n * 2 - offset ? rw : n * 2 - offset;
+        add_limbs(out + offset, n * 2 - offset, coefficients[i - 1], len);
+    }
+}
+
+// operands with at least this many limbs are multiplied through number theoretic transforms
+static int ntt_threshold = 4096;
+
+// number of threads the transforms of the three primes are split into
+static int ntt_threads = 1;
+
+void biguint_set_ntt_threshold(int limbs) { ntt_threshold = limbs < 1 ? 1 : limbs; }
+
+int biguint_ntt_threshold() { return ntt_threshold; }
+
+void biguint_set_ntt_threads(int threads) { ntt_threads = threads < 1 ? 1 : threads > 3 ? 3 : threads; }
+
+int biguint_ntt_threads() { return ntt_threads; }
+
+// primes of the form c * 2^k + 1 with k >= 55, so they have roots of unity for any transform size we can allocate,
+// along with one of their primitive roots. Their product exceeds 2^183, which is larger than any coefficient of the
+// convolution of less than 2^55 limbs of 64 bits
+static const uint64_t NTT_PRIMES[3] = {4179340454199820289ULL, 2485986994308513793ULL, 1945555039024054273ULL};
+static const uint64_t NTT_ROOTS[3] = {3, 5, 5};
+
+typedef struct {
+    uint64_t p;
+    uint64_t p_inv; // -p^(-1) mod 2^64
+    uint64_t r2;    // 2^128 mod p
+} NttPrime;
+
+static uint64_t ntt_pow_plain(uint64_t base, uint64_t exponent, uint64_t p) {
+    uint64_t result = 1;
+    base %= p;
+    while (exponent) {
+        if (exponent & 1)
+            result = (uint64_t)((__uint128_t)result * base % p);
+        base = (uint64_t)((__uint128_t)base * base % p);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+static NttPrime ntt_prime_new(uint64_t p) {
+    NttPrime q = {.p = p};
+    uint64_t inv = 1;
+    for (int i = 0; i < 6; i++)
+        inv *= 2 - p * inv;
+    q.p_inv = -inv;
+    uint64_t r = (uint64_t)(((__uint128_t)1 << 64) % p);
+    q.r2 = (uint64_t)((__uint128_t)r * r % p);
+    return q;
+}
+
+// Montgomery product a * b * 2^(-64) mod p, p < 2^62 keeps every intermediate value in 128 bits
+static uint64_t ntt_mul(uint64_t a, uint64_t b, const NttPrime *q) {
+    __uint128_t t = (__uint128_t)a * b;
+    uint64_t m = (uint64_t)t * q->p_inv;
+    uint64_t u = (uint64_t)((t + (__uint128_t)m * q->p) >> 64);
+    return u >= q->p ? u - q->p : u;
+}
+
+static uint64_t ntt_add(uint64_t a, uint64_t b, uint64_t p) {
+    uint64_t s = a + b;
+    return s >= p ? s - p : s;
+}
+
+static uint64_t ntt_sub(uint64_t a, uint64_t b, uint64_t p) { return a >= b ? a - b : a + p - b; }
+
+// decimation in frequency transform, natural order in and bit reversed order out
+// roots holds w^i in Montgomery form for i < n / 2, where w is a primitive n-th root of unity
+static void ntt_forward(uint64_t *x, int n, const uint64_t *roots, const NttPrime *q) {
+    for (int len = n / 2; len >= 1; len /= 2) {
+        int step = n / (len * 2);
+        for (int start = 0; start < n; start += len * 2) {
+            for (int j = 0; j < len; j++) {
+                uint64_t u = x[start + j], v = x[start + j + len];
+                x[start + j] = ntt_add(u, v, q->p);
+                x[start + j + len] = ntt_mul(ntt_sub(u, v, q->p), roots[j * step], q);
+            }
+        }
+    }
+}
+
+// decimation in time inverse transform (without the 1/n factor), bit reversed order in and natural order out
+// w^(-i) = w^(n - i) = -w^(n/2 - i), so the forward roots are reused
+static void ntt_inverse(uint64_t *x, int n, const uint64_t *roots, const NttPrime *q) {
+    for (int len = 1; len < n; len *= 2) {
+        int step = n / (len * 2);
+        for (int start = 0; start < n; start += len * 2) {
+            for (int j = 0; j < len; j++) {
+                uint64_t w = j == 0 ? roots[0] : q->p - roots[n / 2 - j * step];
+                uint64_t u = x[start + j], v = ntt_mul(x[start + j + len], w, q);
+                x[start + j] = ntt_add(u, v, q->p);
+                x[start + j + len] = ntt_sub(u, v, q->p);
+            }
+        }
+    }
+}
+
+typedef struct {
+    const uint64_t *a;
+    int an;
+    const uint64_t *b;
+    int bn;
+    int n;
+    uint64_t p;
+    uint64_t g;
+    uint64_t *fa; // n limbs, holds the convolution modulo p once done
+    uint64_t *fb; // n limbs, unused when squaring
+    uint64_t *roots; // n / 2 limbs
+} NttJob;
+
+// computes the cyclic convolution of a and b modulo a single prime
+static void *ntt_convolve(void *arg) {
+    NttJob *job = arg;
+    NttPrime q = ntt_prime_new(job->p);
+    int n = job->n;
+
+    uint64_t w = ntt_mul(ntt_pow_plain(job->g, (job->p - 1) / n, job->p), q.r2, &q);
+    job->roots[0] = ntt_mul(1, q.r2, &q);
+    for (int i = 1; i < n / 2; i++)
+        job->roots[i] = ntt_mul(job->roots[i - 1], w, &q);
+
+    for (int i = 0; i < n; i++)
+        job->fa[i] = i < job->an ? job->a[i] % job->p : 0;
+    ntt_forward(job->fa, n, job->roots, &q);
+
+    const uint64_t *fb = job->fa;
+    if (job->a != job->b) {
+        for (int i = 0; i < n; i++)
+            job->fb[i] = i < job->bn ? job->b[i] % job->p : 0;
+        ntt_forward(job->fb, n, job->roots, &q);
+        fb = job->fb;
+    }
+
+    // the pointwise product leaves a 2^(-64) factor and the inverse transform an n one, both are removed at once by
+    // multiplying by n^(-1) * 2^128
+    for (int i = 0; i < n; i++)
+        job->fa[i] = ntt_mul(job->fa[i], fb[i], &q);
+    ntt_inverse(job->fa, n, job->roots, &q);
+
+    uint64_t scale = ntt_mul(ntt_mul(ntt_pow_plain(n, job->p - 2, job->p), q.r2, &q), q.r2, &q);
+    for (int i = 0; i < n; i++)
+        job->fa[i] = ntt_mul(job->fa[i], scale, &q);
+
+    return NULL;
+}
+
+// computes the an + bn limbs product of a and b, when a == b it squares a
+// the limbs are convolved modulo three primes, optionally in parallel, and every coefficient is rebuilt with the
+// chinese remainder theorem (Garner's algorithm) before propagating the carries
+// https://en.wikipedia.org/wiki/Sch%C3%B6nhage%E2%80%93Strassen_algorithm
+static void ntt_mul_limbs(const uint64_t *a, int an, const uint64_t *b, int bn, uint64_t *out) {
+    int n = 1;
+    while (n < an + bn - 1)
+        n *= 2;
+    if (n < 2)
+        n = 2;
+
+    int sqr = a == b;
+    int job_size = n * (sqr ? 1 : 2) + n / 2;
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *memory = biguint_arena_alloc(arena, (size_t)job_size * 3);
+
+    NttJob jobs[3];
+    for (int i = 0; i < 3; i++) {
+        uint64_t *base = memory + (size_t)job_size * i;
+        jobs[i] = (NttJob){.a = a, .an = an, .b = b, .bn = bn, .n = n, .p = NTT_PRIMES[i], .g = NTT_ROOTS[i]};
+        jobs[i].fa = base;
+        jobs[i].fb = sqr ? NULL : base + n;
+        jobs[i].roots = base + n * (sqr ? 1 : 2);
+    }
+
+    // job i runs on its own thread unless it falls on the calling one (i % ntt_threads == 0)
+    pthread_t threads[3];
+    int spawned[3] = {0};
+    for (int i = 0; i < 3; i++) {
+        if (i % ntt_threads != 0)
+            spawned[i] = pthread_create(&threads[i], NULL, ntt_convolve, &jobs[i]) == 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        if (!spawned[i])
+            ntt_convolve(&jobs[i]);
+    }
+    for (int i = 0; i < 3; i++) {
+        if (spawned[i])
+            pthread_join(threads[i], NULL);
+    }
+
+    uint64_t p1 = NTT_PRIMES[0], p2 = NTT_PRIMES[1], p3 = NTT_PRIMES[2];
+    uint64_t p1_inv_p2 = ntt_pow_plain(p1, p2 - 2, p2);
+    uint64_t p1_p2_inv_p3 = ntt_pow_plain((uint64_t)((__uint128_t)p1 * p2 % p3), p3 - 2, p3);
+    __uint128_t p1_p2 = (__uint128_t)p1 * p2;
+
+    uint64_t carry_lo = 0, carry_hi = 0;
+    for (int i = 0; i < an + bn; i++) {
+        uint64_t x0 = 0, x1 = 0, x2 = 0;
+        if (i < an + bn - 1) {
+            uint64_t r1 = jobs[0].fa[i], r2 = jobs[1].fa[i], r3 = jobs[2].fa[i];
+
+            // x = v1 + v2 * p1 + v3 * p1 * p2
+            uint64_t v1 = r1;
+            uint64_t v2 = (uint64_t)((__uint128_t)ntt_sub(r2, v1 % p2, p2) * p1_inv_p2 % p2);
+            uint64_t t = ntt_sub(r3, v1 % p3, p3);
+            t = ntt_sub(t, (uint64_t)((__uint128_t)v2 * p1 % p3), p3);
+            uint64_t v3 = (uint64_t)((__uint128_t)t * p1_p2_inv_p3 % p3);
+
+            __uint128_t lo = (__uint128_t)v3 * (uint64_t)p1_p2;
+            __uint128_t hi = (__uint128_t)v3 * (uint64_t)(p1_p2 >> 64) + (uint64_t)(lo >> 64);
+            x0 = (uint64_t)lo;
+            x1 = (uint64_t)hi;
+            x2 = (uint64_t)(hi >> 64);
+
+            __uint128_t s = (__uint128_t)x0 + (uint64_t)((__uint128_t)v2 * p1) + v1;
+            x0 = (uint64_t)s;
+            s = (s >> 64) + x1 + (uint64_t)(((__uint128_t)v2 * p1) >> 64);
+            x1 = (uint64_t)s;
+            x2 += (uint64_t)(s >> 64);
+        }
+
+        __uint128_t s = (__uint128_t)x0 + carry_lo;
+        out[i] = (uint64_t)s;
+        s = (s >> 64) + x1 + carry_hi;
+        carry_lo = (uint64_t)s;
+        carry_hi = (uint64_t)(s >> 64) + x2;
+    }
+
+    biguint_arena_reset(arena, mark);
+}
+
+// number of scratch limbs needed by `mul_n_limbs` for n limbs operands
+static int mul_n_scratch_size(int n) {
+    if (n >= ntt_threshold)
+        return 0;
+    if (n < toom3_threshold)
+        return karatsuba_scratch_size(n);
+    return toom3_level_scratch_size(n) + mul_n_scratch_size((n + 2) / 3 + 1);
+}
+
+// computes the 2n limbs product of a and b, both of n limbs, picking the algorithm by size, when a == b it squares a
+static void mul_n_limbs(const uint64_t *a, const uint64_t *b, int n, uint64_t *out, uint64_t *scratch) {
+    if (n >= ntt_threshold)
+        ntt_mul_limbs(a, n, b, n, out);
+    else if (n >= toom3_threshold)
+        toom3_limbs(a, b, n, out, scratch);
+    else
+        karatsuba_limbs(a, b, n, out, scratch);
+}
+
+// number of scratch limbs needed by `mul_full_limbs` when the shorter operand has bn limbs
+static int mul_full_scratch_size(int bn) {
+    if (bn < karatsuba_threshold || bn >= ntt_threshold)
+        return 0;
+    return bn * 3 + mul_n_scratch_size(bn);
+}
+
+// computes the an + bn limbs product of a and b, operands of different lengths are multiplied in chunks of the
+// shorter length
+static void mul_full_limbs(const uint64_t *a, int an, const uint64_t *b, int bn, uint64_t *out, uint64_t *scratch) {
+    if (an < bn) {
+        mul_full_limbs(b, bn, a, an, out, scratch);
+        return;
+    }
+    if (bn < karatsuba_threshold) {
+        // squares compute each cross product once, karatsuba and the ntt check for them on their own
+        if (a == b && an == bn)
+            sqr_limbs(a, an, out, an * 2);
+        else
+            mul_limbs(a, an, b, bn, out, an + bn);
+        return;
+    }
+    if (bn >= ntt_threshold) {
+        ntt_mul_limbs(a, an, b, bn, out);
+        return;
+    }
+    if (an == bn) {
+        mul_n_limbs(a, b, bn, out, scratch);
+        return;
+    }
+
+    uint64_t *chunk_product = scratch, *padded = scratch + bn * 2, *next = padded + bn;
+    for (int i = 0; i < an + bn; i++)
+        out[i] = 0;
+
+    for (int i = 0; i < an; i += bn) {
+        int chunk = an - i < bn ? an - i : bn;
+        if (chunk == bn) {
+            mul_n_limbs(a + i, b, bn, chunk_product, next);
+        } else if (chunk < karatsuba_threshold) {
+            mul_limbs(a + i, chunk, b, bn, chunk_product, chunk + bn);
+        } else {
+            for (int j = 0; j < bn; j++)
+                padded[j] = j < chunk ? a[i + j] : 0;
+            mul_n_limbs(padded, b, bn, chunk_product, next);
+        }
+        add_limbs(out + i, an + bn - i, chunk_product, chunk + bn);
+    }
+}
+
+// number of scratch limbs needed by `mul_low_limbs` for n limbs operands
+static int mul_low_scratch_size(int n) {
+    if (n < karatsuba_threshold)
+        return 0;
+    int l = n / 2, h = n - l;
+    // the truncated cross products recurse after their own l limbs output
+    int full = h * 2 + mul_n_scratch_size(h), low = l + mul_low_scratch_size(l);
+    return full > low ? full : low;
+}
+
+// computes the lower n limbs of the product of a and b, both of n limbs
+// only a0 * b0 is computed in full, the cross products a0 * b1 and a1 * b0 are truncated as well, while a1 * b1 is
+// not needed at all
+static void mul_low_limbs(const uint64_t *a, const uint64_t *b, int n, uint64_t *out, uint64_t *scratch) {
+    if (n < karatsuba_threshold) {
+        if (a == b)
+            sqr_limbs(a, n, out, n);
+        else
+            mul_limbs(a, n, b, n, out, n);
+        return;
+    }
+
+    int l = n / 2, h = n - l;
+    mul_n_limbs(a, b, h, scratch, scratch + h * 2);
+    for (int i = 0; i < n; i++)
+        out[i] = scratch[i];
+
+    // when squaring both cross products are the same one
+    mul_low_limbs(a + h, b, l, scratch, scratch + l);
+    add_limbs(out + h, l, scratch, l);
+    if (a != b)
+        mul_low_limbs(a, b + h, l, scratch, scratch + l);
+    add_limbs(out + h, l, scratch, l);
+}
+
+int biguint_mul_scratch_size(BigUint a, BigUint b, BigUint out) {
+    int an = biguint_len(a), bn = biguint_len(b), n = out.size;
+    int full = an + bn + mul_full_scratch_size(an < bn ? an : bn);
+    int low = n * 3 + mul_low_scratch_size(n);
+    return full > low ? full : low;
+}
+
+// writes the lower limbs of a * b into out and returns 1 if the product does not fit
+static int mul_with_scratch(BigUint a, BigUint b, BigUint *out, uint64_t *scratch, int check_overflow) {
+    int an = biguint_len(a), bn = biguint_len(b), n = out->size;
+    if (an == 0 || bn == 0) {
+        biguint_zero(out);
+        return 0;
+    }
+
+    // the product has at least an + bn - 1 limbs, when they are more than what out can hold computing the full
+    // product is a waste, only the lower n limbs are computed and it surely overflows
+    if (an + bn - 1 > n || (!check_overflow && an + bn > n)) {
+        uint64_t *x = scratch, *y = x + n, *low = y + n;
+        load_limbs(a, n, x);
+        if (a.limbs == b.limbs)
+            y = x;
+        else
+            load_limbs(b, n, y);
+        mul_low_limbs(x, y, n, low, x + n * 3);
+        store_limbs(low, n, out);
+        return an + bn - 1 > n;
+    }
+
+    uint64_t *product = scratch;
+    mul_full_limbs(a.limbs, an, b.limbs, bn, product, product + an + bn);
+    store_limbs(product, an + bn, out);
+    return an + bn > n && product[an + bn - 1] != 0;
+}
+
+void biguint_mul_with_scratch(BigUint a, BigUint b, BigUint *out, uint64_t *scratch) {
+    mul_with_scratch(a, b, out, scratch, 1);
+}
+
+int biguint_overflow_mul(BigUint a, BigUint b, BigUint *out) {
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *scratch = biguint_arena_alloc(arena, biguint_mul_scratch_size(a, b, *out));
+    int overflow = mul_with_scratch(a, b, out, scratch, 1);
+    biguint_arena_reset(arena, mark);
+    return overflow;
+}
+
+void biguint_mul_low(BigUint a, BigUint b, BigUint *out) {
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *scratch = biguint_arena_alloc(arena, biguint_mul_scratch_size(a, b, *out));
+    mul_with_scratch(a, b, out, scratch, 0);
+    biguint_arena_reset(arena, mark);
+}
+
+void biguint_mul(BigUint a, BigUint b, BigUint *out) { biguint_overflow_mul(a, b, out); }
+
+// operands sharing their limbs are detected all the way down, and squared instead of multiplied
+int biguint_overflow_sqr(BigUint a, BigUint *out) { return biguint_overflow_mul(a, a, out); }
+
+void biguint_sqr(BigUint a, BigUint *out) { biguint_overflow_mul(a, a, out); }
+
+// the full product is kept, sized after the significant limbs of the operands rather than their capacity
+void biguint_mul_mod(BigUint a, BigUint b, BigUint m, BigUint *out) {
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint result = biguint_arena_new(arena, biguint_len(a) + biguint_len(b) + 1);
+
+    biguint_mul(a, b, &result);
+    biguint_mod(result, m, out);
+
+    biguint_arena_reset(arena, mark);
+}
+
+void biguint_sqr_mod(BigUint a, BigUint m, BigUint *out) {
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    BigUint result = biguint_arena_new(arena, biguint_len(a) * 2 + 1);
+
+    biguint_sqr(a, &result);
+    biguint_mod(result, m, out);
+
+    biguint_arena_reset(arena, mark);
+}
+
+// https://en.wikipedia.org/wiki/Exponentiation_by_squaring
+// the exponent bits are scanned from the most significant one, every intermediate value is a smaller power of a,
+// hence if any of them overflows so does the result
+int biguint_overflow_pow(BigUint a, BigUint exponent, BigUint *out) {
+    int bits = biguint_bits(exponent);
+    if (bits == 0) {
+        biguint_one(out);
+        return 0;
+    }
+
+    // out may be a itself
+    uint64_t base_limbs[a.size];
+    BigUint base = biguint_new_from_limbs(a.size, base_limbs);
+    biguint_cpy(&base, a);
+    biguint_cpy(out, base);
+    int overflow = biguint_len(base) > out->size;
+
+    for (int i = bits - 2; i >= 0; i--) {
+        overflow |= biguint_overflow_sqr(*out, out);
+        if ((exponent.limbs[i / 64] >> (i % 64)) & 1)
+            overflow |= biguint_overflow_mul(*out, base, out);
+    }
+
+    return overflow;
+}
+
+void biguint_pow(BigUint a, BigUint exponent, BigUint *out) { biguint_overflow_pow(a, exponent, out); }
+
+// performs a pow operation keeping the result in bounds over a mod m, using the following identity:
+// (a ⋅ b) mod m = [(a mod m) ⋅ (b mod m)] mod m
+// https://en.wikipedia.org/wiki/Modular_exponentiation
+void biguint_pow_mod(BigUint a, BigUint exponent, BigUint m, BigUint *out) {
+    if (biguint_is_zero(exponent)) {
+        biguint_one(out);
+        return;
+    }
+
+    // the context comes from the scratch arena, so once it has grown there is no allocation left per call
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+
+    // odd moduli can be handled in the montgomery domain, where there are no divisions involved
+    if (!biguint_is_even(m)) {
+        BigUintMontCtx ctx;
+        biguint_mont_ctx_init_with_limbs(m, biguint_arena_alloc(arena, m.size * 2), &ctx);
+        biguint_pow_mod_mont(a, exponent, ctx, out);
+    } else {
+        BigUintBarrettCtx ctx;
+        biguint_barrett_ctx_init_with_limbs(m, biguint_arena_alloc(arena, m.size * 2 + 1), &ctx);
+        biguint_pow_mod_barrett(a, exponent, ctx, out);
+    }
+
+    biguint_arena_reset(arena, mark);
+}
+
+void biguint_bitand(BigUint a, BigUint b, BigUint *out) {
+    int limit = get_min_size_three(a, b, *out);
+    for (int i = 0; i < limit; i++)
+        out->limbs[i] = a.limbs[i] & b.limbs[i];
+}
+
+void biguint_bitor(BigUint a, BigUint b, BigUint *out) {
+    int limit = get_min_size_three(a, b, *out);
+    for (int i = 0; i < limit; i++)
+        out->limbs[i] = a.limbs[i] | b.limbs[i];
+}
+
+void biguint_bitxor(BigUint a, BigUint b, BigUint *out) {
+    int limit = get_min_size(a, b);
+    for (int i = 0; i < limit; i++)
+        out->limbs[i] = a.limbs[i] ^ b.limbs[i];
+}
+
+void biguint_bitnot(BigUint a, BigUint *out) {
+    int limit = get_min_size(a, *out);
+    for (int i = 0; i < limit; i++)
+        out->limbs[i] = ~a.limbs[i];
+}
+
+// writes the n lower limbs of a << shift into out, a having an limbs
+// limbs are written from the most significant one, each reading only limbs at or below its own index, so out may be a
+static void shl_limbs(const uint64_t *a, int an, int shift, uint64_t *out, int n) {
+    int limb_shift = shift / 64, bit_shift = shift % 64;
+    for (int i = n - 1; i >= 0; i--) {
+        int j = i - limb_shift;
+        uint64_t hi = j >= 0 && j < an ? a[j] : 0;
+        uint64_t lo = j >= 1 && j - 1 < an ? a[j - 1] : 0;
+        out[i] = bit_shift ? (hi << bit_shift) | (lo >> (64 - bit_shift)) : hi;
+    }
+}
+
+// writes the n lower limbs of a >> shift into out, a having an limbs
+// limbs are written from the least significant one, each reading only limbs at or above its own index, so out may be a
+static void shr_limbs(const uint64_t *a, int an, int shift, uint64_t *out, int n) {
+    int limb_shift = shift / 64, bit_shift = shift % 64;
+    for (int i = 0; i < n; i++) {
+        int j = i + limb_shift;
+        uint64_t lo = j < an ? a[j] : 0;
+        uint64_t hi = j + 1 < an ? a[j + 1] : 0;
+        out[i] = bit_shift ? (lo >> bit_shift) | (hi << (64 - bit_shift)) : lo;
+    }
+}
+
+void biguint_shl(BigUint a, int shift, BigUint *out) {
+    int limit = get_min_size(a, *out);
+    shl_limbs(a.limbs, limit, shift, out->limbs, limit);
+    for (int i = limit; i < out->size; i++)
+        out->limbs[i] = 0;
+}
+
+void biguint_shr(BigUint a, int shift, BigUint *out) {
+    int limit = get_min_size(a, *out);
+    shr_limbs(a.limbs, limit, shift, out->limbs, limit);
+    for (int i = limit; i < out->size; i++)
+        out->limbs[i] = 0;
+}
+
+// divides the an limbs of a by the single limb d, the quotient is written into quot (if not NULL) and the remainder
+// returned
+static uint64_t divmod_u64_limbs(const uint64_t *a, int an, uint64_t d, uint64_t *quot) {
+    uint64_t rem = 0;
+    for (int i = an - 1; i >= 0; i--) {
+        __uint128_t num = ((__uint128_t)rem << 64) | a[i];
+        uint64_t q = (uint64_t)(num / d);
+        rem = (uint64_t)(num - (__uint128_t)q * d);
+        if (quot)
+            quot[i] = q;
+    }
+    return rem;
+}
+
+// the core of Knuth's algorithm D: divides the un limbs of u, whose top n limbs are below v, by the n >= 2 limbs of v,
+// normalized so that its top bit is set, with v_inv the `u64_reciprocal` of its top limb. It writes the un - n quotient
+// limbs into quot (only when not NULL) and leaves the remainder in the low n limbs of u
+static void divrem_normalized_limbs(uint64_t *u, int un, const uint64_t *v, int n, uint64_t v_inv, uint64_t *quot) {
+    for (int j = un - n - 1; j >= 0; j--) {
+        // estimate the quotient digit from the top two limbs of the current remainder and the top limb of v, estimates
+        // of 2^64 or more are lowered to 2^64 - 1 right away, as the actual digit always fits in a limb
+        __uint128_t qhat, rhat;
+        if (u[j + n] >= v[n - 1]) {
+            qhat = ~0ULL;
+            rhat = (((__uint128_t)u[j + n] << 64) | u[j + n - 1]) - qhat * v[n - 1];
+        } else {
+            uint64_t r;
+            qhat = u64_div_2by1_preinv(u[j + n], u[j + n - 1], v[n - 1], v_inv, &r);
+            rhat = r;
+        }
+        while ((rhat >> 64) == 0 && qhat * v[n - 2] > ((rhat << 64) | u[j + n - 2])) {
+            qhat--;
+            rhat += v[n - 1];
+        }
+
+        // u[j..j + n] -= qhat * v
+        uint64_t q = (uint64_t)qhat;
+        uint64_t mul_carry = 0;
+        uint64_t borrow = 0;
+        for (int i = 0; i < n; i++) {
+            __uint128_t p = (__uint128_t)q * v[i] + mul_carry;
+            mul_carry = (uint64_t)(p >> 64);
+            u[i + j] = u64_subb(u[i + j], (uint64_t)p, borrow, &borrow);
+        }
+        uint64_t top_borrow;
+        u[j + n] = u64_subb(u[j + n], mul_carry, borrow, &top_borrow);
+
+        // the estimate was one unit too large, add v back
+        if (top_borrow) {
+            q--;
+            uint64_t carry = 0;
+            for (int i = 0; i < n; i++) {
+                __uint128_t sum = (__uint128_t)u[i + j] + v[i] + carry;
+                u[i + j] = (uint64_t)sum;
+                carry = (uint64_t)(sum >> 64);
+            }
+            u[j + n] += carry;
+        }
+
+        if (quot)
+            quot[j] = q;
+    }
+}
+
+// Knuth's algorithm D: long division one limb at a time
+// given the an limbs of a and the bn significant limbs of b (an >= bn), it writes the an - bn + 1 limbs of the
+// quotient into quot (only when not NULL) and the bn limbs of the remainder into rem
+//
+// see The Art of Computer Programming vol. 2, section 4.3.1
+static void divmod_limbs(const uint64_t *a, int an, const uint64_t *b, int bn, uint64_t *quot, uint64_t *rem) {
+    if (bn == 1) {
+        rem[0] = divmod_u64_limbs(a, an, b[0], quot);
+        return;
+    }
+
+    // the normalized operands grow with the dividend, so they come from the scratch arena rather than the stack
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *v = biguint_arena_alloc(arena, bn);
+    uint64_t *u = biguint_arena_alloc(arena, an + 1);
+
+    // normalize so that the top bit of the divisor is set, that way every quotient estimate is off by 2 at most
+    int shift = u64_leading_zeros(b[bn - 1]);
+    for (int i = bn - 1; i > 0; i--)
+        v[i] = shift ? (b[i] << shift) | (b[i - 1] >> (64 - shift)) : b[i];
+    v[0] = b[0] << shift;
+    u[an] = shift ? a[an - 1] >> (64 - shift) : 0;
+    for (int i = an - 1; i > 0; i--)
+        u[i] = shift ? (a[i] << shift) | (a[i - 1] >> (64 - shift)) : a[i];
+    u[0] = a[0] << shift;
+
+    divrem_normalized_limbs(u, an + 1, v, bn, u64_reciprocal(v[bn - 1]), quot);
+
+    // unnormalize the remainder
+    for (int i = 0; i < bn - 1; i++)
+        rem[i] = shift ? (u[i] >> shift) | (u[i + 1] << (64 - shift)) : u[i];
+    rem[bn - 1] = u[bn - 1] >> shift;
+
+    biguint_arena_reset(arena, mark);
+}
+
+void biguint_divmod(BigUint a, BigUint b, BigUint *quot, BigUint *rem) {
+    int an = biguint_len(a);
+    int bn = biguint_len(b);
+    assert(bn != 0);
+
+    if (an < bn) {
+        biguint_cpy(rem, a);
+        biguint_zero(quot);
+        return;
+    }
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *q = biguint_arena_alloc(arena, an - bn + 1);
+    uint64_t *r = biguint_arena_alloc(arena, bn);
+
+    divmod_limbs(a.limbs, an, b.limbs, bn, q, r);
+    store_limbs(q, an - bn + 1, quot);
+    store_limbs(r, bn, rem);
+
+    biguint_arena_reset(arena, mark);
+}
+
+void biguint_div(BigUint a, BigUint b, BigUint *out) {
+    int an = biguint_len(a);
+    int bn = biguint_len(b);
+    assert(bn != 0);
+
+    if (an < bn) {
+        biguint_zero(out);
+        return;
+    }
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *q = biguint_arena_alloc(arena, an - bn + 1);
+    uint64_t *r = biguint_arena_alloc(arena, bn);
+
+    divmod_limbs(a.limbs, an, b.limbs, bn, q, r);
+    store_limbs(q, an - bn + 1, out);
+
+    biguint_arena_reset(arena, mark);
+}
+
+void biguint_mod(BigUint a, BigUint b, BigUint *out) {
+    int an = biguint_len(a);
+    int bn = biguint_len(b);
+    assert(bn != 0);
+
+    if (an < bn) {
+        biguint_cpy(out, a);
+        return;
+    }
+
+    // remainder only, the quotient digits are not stored
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *r = biguint_arena_alloc(arena, bn);
+
+    divmod_limbs(a.limbs, an, b.limbs, bn, NULL, r);
+    store_limbs(r, bn, out);
+
+    biguint_arena_reset(arena, mark);
+}
+
+static int cmp_limbs(const uint64_t *a, const uint64_t *b, int n) {
+    for (int i = n - 1; i >= 0; i--) {
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// the normalized modulus, the normalized b and the n + 2 limbs running remainder
+int biguint_mul_mod_ws_size(int n) { return n * 3 + 2; }
+
+// the modulus is normalized as v = m * 2^s, so that its top bit is set, and the running remainder is kept as
+// r * 2^s mod v = 2^s * (r mod m). Every limb of a then adds a_i * b to r * 2^64, which stays below 2^65 * v, and a
+// single quotient digit brings it back below v
+void biguint_mul_mod_ws(BigUint a, BigUint b, BigUint m, BigUint *out, uint64_t *ws) {
+    int n = biguint_len(m);
+    assert(n != 0);
+    int an = biguint_len(a), bn = biguint_len(b);
+
+    if (n == 1) {
+        uint64_t ar = divmod_u64_limbs(a.limbs, an, m.limbs[0], NULL);
+        uint64_t br = divmod_u64_limbs(b.limbs, bn, m.limbs[0], NULL);
+        uint64_t r = (uint64_t)((__uint128_t)ar * br % m.limbs[0]);
+        store_limbs(&r, 1, out);
+        return;
+    }
+
+    uint64_t *v = ws, *bs = ws + n, *x = ws + n * 2;
+    int shift = u64_leading_zeros(m.limbs[n - 1]);
+    for (int i = n - 1; i > 0; i--)
+        v[i] = shift ? (m.limbs[i] << shift) | (m.limbs[i - 1] >> (64 - shift)) : m.limbs[i];
+    v[0] = m.limbs[0] << shift;
+
+    uint64_t v_inv = u64_reciprocal(v[n - 1]);
+
+    // bs = b * 2^s mod v, which is just b * 2^s for b below m, otherwise the limbs of b * 2^s are fed from the top into
+    // the remainder held in x[1..n]
+    if (bn < n || (bn == n && biguint_cmp(b, m) < 0)) {
+        for (int i = n - 1; i >= 0; i--) {
+            uint64_t limb = i < bn ? b.limbs[i] << shift : 0;
+            if (shift && i > 0 && i <= bn)
+                limb |= b.limbs[i - 1] >> (64 - shift);
+            bs[i] = limb;
+        }
+    } else {
+        for (int i = 1; i <= n; i++)
+            x[i] = 0;
+        for (int i = bn; i >= 0; i--) {
+            uint64_t limb = i < bn ? b.limbs[i] << shift : 0;
+            if (shift && i > 0)
+                limb |= b.limbs[i - 1] >> (64 - shift);
+            x[0] = limb;
+            divrem_normalized_limbs(x, n + 1, v, n, v_inv, NULL);
+            memmove(x + 1, x, n * sizeof(uint64_t));
+        }
+        memcpy(bs, x + 1, n * sizeof(uint64_t));
+    }
+
+    // r = (r * 2^64 + a_i * bs) mod v for every limb of a from the top, r held in x[1..n]
+    for (int i = 1; i <= n; i++)
+        x[i] = 0;
+    for (int i = an - 1; i >= 0; i--) {
+        x[0] = 0;
+        uint64_t carry = addmul_1(x, bs, n, a.limbs[i]);
+        x[n] = u64_addc(x[n], carry, 0, &x[n + 1]);
+
+        // x < 2^65 * v, a subtraction of 2^64 * v at most leaves a single quotient digit
+        if (x[n + 1] || cmp_limbs(x + 1, v, n) >= 0)
+            sub_limbs(x + 1, n + 1, v, n);
+        divrem_normalized_limbs(x, n + 1, v, n, v_inv, NULL);
+        memmove(x + 1, x, n * sizeof(uint64_t));
+    }
+
+    // unnormalize
+    for (int i = 0; i < n - 1; i++)
+        x[i] = shift ? (x[i + 1] >> shift) | (x[i + 2] << (64 - shift)) : x[i + 1];
+    x[n - 1] = x[n] >> shift;
+    store_limbs(x, n, out);
 }
 
 int biguint_is_even(BigUint a) { return (a.limbs[0] & 1) == 0; }
 
+/**
+ * Exponentiation
+ */
+
+// computes `a * b` reduced by ctx into out, all of them n limbs residues, scratch has `mod_mul_scratch_size(n)` limbs
+typedef void (*ModMulFn)(const uint64_t *a, const uint64_t *b, const void *ctx, uint64_t *out, uint64_t *scratch);
+
+static int mod_mul_scratch_size(int n) { return n * 2 + 1 + mul_n_scratch_size(n); }
+
+// picks the sliding window width minimizing squarings plus multiplications for an exponent of the given bits
+static int pow_window_bits(int bits) {
+    if (bits <= 8)
+        return 1;
+    if (bits <= 24)
+        return 2;
+    if (bits <= 80)
+        return 3;
+    if (bits <= 240)
+        return 4;
+    if (bits <= 672)
+        return 5;
+    if (bits <= 1792)
+        return 6;
+    return 7;
+}
+
+// computes base^exponent with a left to right sliding window over the exponent bits, which are read in place
+// only odd powers base^1, base^3, ..., base^(2^w - 1) are precomputed, each table entry starts on its own cache line
+// https://en.wikipedia.org/wiki/Exponentiation_by_squaring#Sliding-window_method
+static void pow_window_limbs(const uint64_t *base, const uint64_t *one, BigUint exponent, int n, ModMulFn mul,
+                             const void *ctx, uint64_t *out) {
+    int bits = biguint_bits(exponent);
+    int w = pow_window_bits(bits);
+    int entries = 1 << (w - 1);
+    int stride = (n + 7) & ~7;
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *scratch = biguint_arena_alloc(arena, mod_mul_scratch_size(n) + 1);
+    uint64_t *memory = biguint_arena_alloc(arena, (size_t)entries * stride + 8);
+    uint64_t *table = (uint64_t *)(((uintptr_t)memory + 63) & ~(uintptr_t)63);
+
+    // table[k] = base^(2k + 1)
+    for (int i = 0; i < n; i++)
+        table[i] = base[i];
+    if (entries > 1) {
+        uint64_t base_sqr[n];
+        mul(base, base, ctx, base_sqr, scratch);
+        for (int k = 1; k < entries; k++)
+            mul(table + (size_t)(k - 1) * stride, base_sqr, ctx, table + (size_t)k * stride, scratch);
+    }
+
+    uint64_t acc[n];
+    int started = 0;
+    for (int i = 0; i < n; i++)
+        acc[i] = one[i];
+
+    int i = bits - 1;
+    while (i >= 0) {
+        if (!((exponent.limbs[i / 64] >> (i % 64)) & 1)) {
+            mul(acc, acc, ctx, acc, scratch);
+            i--;
+            continue;
+        }
+
+        // the window spans bits i..j, and ends on a set bit so its value is odd
+        int j = i - w + 1 < 0 ? 0 : i - w + 1;
+        while (!((exponent.limbs[j / 64] >> (j % 64)) & 1))
+            j++;
+
+        int value = 0;
+        for (int k = i; k >= j; k--)
+            value = (value << 1) | ((exponent.limbs[k / 64] >> (k % 64)) & 1);
+
+        const uint64_t *power = table + (size_t)(value >> 1) * stride;
+        if (started) {
+            for (int k = i; k >= j; k--)
+                mul(acc, acc, ctx, acc, scratch);
+            mul(acc, power, ctx, acc, scratch);
+        } else {
+            // nothing to square yet
+            for (int k = 0; k < n; k++)
+                acc[k] = power[k];
+            started = 1;
+        }
+        i = j - 1;
+    }
+
+    for (int k = 0; k < n; k++)
+        out[k] = acc[k];
+    biguint_arena_reset(arena, mark);
+}
+
+// bucket widths tried by the pippenger multi exponentiation, 2^12 buckets being already well past any useful size
+#define MULTI_POW_MAX_BUCKET_BITS 12
+
+// the c bits of an exponent starting at bit pos, zero past its end
+static int exponent_bits_at(BigUint exponent, int pos, int c) {
+    int limb = pos / 64, shift = pos % 64;
+    if (limb >= exponent.size)
+        return 0;
+    uint64_t bits = exponent.limbs[limb] >> shift;
+    if (shift + c > 64 && limb + 1 < exponent.size)
+        bits |= exponent.limbs[limb + 1] << (64 - shift);
+    return (int)(bits & ((1ULL << c) - 1));
+}
+
+// splits an exponent into left to right sliding windows of up to w bits, as pow_window_limbs does, writing each
+// window's odd value at the position of its lowest bit, and zero everywhere else
+static void pow_window_digits(BigUint exponent, int w, uint8_t *digits) {
+    int i = biguint_bits(exponent) - 1;
+    while (i >= 0) {
+        if (!((exponent.limbs[i / 64] >> (i % 64)) & 1)) {
+            digits[i--] = 0;
+            continue;
+        }
+        int j = i - w + 1 < 0 ? 0 : i - w + 1;
+        while (!((exponent.limbs[j / 64] >> (j % 64)) & 1))
+            j++;
+
+        int value = 0;
+        for (int k = i; k >= j; k--) {
+            value = (value << 1) | ((exponent.limbs[k / 64] >> (k % 64)) & 1);
+            digits[k] = 0;
+        }
+        digits[j] = value;
+        i = j - 1;
+    }
+}
+
+// Straus' interleaved exponentiation: each base gets its own table of odd powers and sliding windows, while the
+// squarings of the accumulator are shared by all of them
+// https://cr.yp.to/papers/pippenger.pdf
+static void multi_pow_straus_limbs(const uint64_t *bases, const uint64_t *one, const BigUint *exponents, int count,
+                                   int bits, int n, ModMulFn mul, const void *ctx, uint64_t *out) {
+    int w = pow_window_bits(bits);
+    int entries = 1 << (w - 1);
+    int stride = (n + 7) & ~7;
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *scratch = biguint_arena_alloc(arena, mod_mul_scratch_size(n) + 1);
+    uint64_t *memory = biguint_arena_alloc(arena, (size_t)count * entries * stride + 8);
+    uint64_t *tables = (uint64_t *)(((uintptr_t)memory + 63) & ~(uintptr_t)63);
+    uint8_t *digits = (uint8_t *)biguint_arena_alloc(arena, ((size_t)count * bits + 7) / 8);
+
+    // tables[k][e] = bases[k]^(2e + 1)
+    uint64_t base_sqr[n];
+    for (int k = 0; k < count; k++) {
+        uint64_t *table = tables + (size_t)k * entries * stride;
+        for (int i = 0; i < n; i++)
+            table[i] = bases[(size_t)k * n + i];
+        if (entries > 1) {
+            mul(table, table, ctx, base_sqr, scratch);
+            for (int e = 1; e < entries; e++)
+                mul(table + (size_t)(e - 1) * stride, base_sqr, ctx, table + (size_t)e * stride, scratch);
+        }
+        memset(digits + (size_t)k * bits, 0, bits);
+        pow_window_digits(exponents[k], w, digits + (size_t)k * bits);
+    }
+
+    uint64_t acc[n];
+    int started = 0;
+    for (int i = 0; i < n; i++)
+        acc[i] = one[i];
+
+    for (int i = bits - 1; i >= 0; i--) {
+        if (started)
+            mul(acc, acc, ctx, acc, scratch);
+        for (int k = 0; k < count; k++) {
+            int digit = digits[(size_t)k * bits + i];
+            if (!digit)
+                continue;
+            const uint64_t *power = tables + ((size_t)k * entries + (digit >> 1)) * stride;
+            if (started) {
+                mul(acc, power, ctx, acc, scratch);
+            } else {
+                for (int j = 0; j < n; j++)
+                    acc[j] = power[j];
+                started = 1;
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+        out[i] = acc[i];
+    biguint_arena_reset(arena, mark);
+}
+
+// Pippenger's bucket method: for every c bits digit position, the bases are multiplied into the bucket of their digit
+// d, then prod(bucket_d^d) is obtained with 2 * 2^c multiplications as the product of the running products from the
+// top bucket down, so each base costs a single multiplication per digit
+// https://cr.yp.to/papers/pippenger.pdf
+static void multi_pow_pippenger_limbs(const uint64_t *bases, const uint64_t *one, const BigUint *exponents, int count,
+                                      int bits, int c, int n, ModMulFn mul, const void *ctx, uint64_t *out) {
+    int buckets = (1 << c) - 1;
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    uint64_t *scratch = biguint_arena_alloc(arena, mod_mul_scratch_size(n) + 1);
+    uint64_t *bucket = biguint_arena_alloc(arena, (size_t)buckets * n);
+    uint8_t *used = (uint8_t *)biguint_arena_alloc(arena, (buckets + 7) / 8);
+
+    uint64_t acc[n], running[n], total[n];
+    int started = 0;
+    for (int i = 0; i < n; i++)
+        acc[i] = one[i];
+
+    for (int pos = (bits - 1) / c * c; pos >= 0; pos -= c) {
+        if (started)
+            for (int i = 0; i < c; i++)
+                mul(acc, acc, ctx, acc, scratch);
+
+        memset(used, 0, buckets);
+        for (int k = 0; k < count; k++) {
+            int digit = exponent_bits_at(exponents[k], pos, c);
+            if (!digit)
+                continue;
+            uint64_t *b = bucket + (size_t)(digit - 1) * n;
+            if (used[digit - 1]) {
+                mul(b, bases + (size_t)k * n, ctx, b, scratch);
+            } else {
+                memcpy(b, bases + (size_t)k * n, n * sizeof(uint64_t));
+                used[digit - 1] = 1;
+            }
+        }
+
+        // running = prod(bucket_e) for e >= d, total = prod(running_d) = prod(bucket_d^d)
+        int running_started = 0, total_started = 0;
+        for (int d = buckets; d >= 1; d--) {
+            if (used[d - 1]) {
+                if (running_started) {
+                    mul(running, bucket + (size_t)(d - 1) * n, ctx, running, scratch);
+                } else {
+                    memcpy(running, bucket + (size_t)(d - 1) * n, n * sizeof(uint64_t));
+                    running_started = 1;
+                }
+            }
+            if (!running_started)
+                continue;
+            if (total_started) {
+                mul(total, running, ctx, total, scratch);
+            } else {
+                memcpy(total, running, n * sizeof(uint64_t));
+                total_started = 1;
+            }
+        }
+
+        if (!total_started)
+            continue;
+        if (started) {
+            mul(acc, total, ctx, acc, scratch);
+        } else {
+            memcpy(acc, total, n * sizeof(uint64_t));
+            started = 1;
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+        out[i] = acc[i];
+    biguint_arena_reset(arena, mark);
+}
+
+// computes prod(bases[k]^exponents[k]), the bases being count consecutive n limbs residues, picking whichever of
+// straus and pippenger needs fewer multiplications, squarings aside since both share them across the bases
+static void multi_pow_limbs(const uint64_t *bases, const uint64_t *one, const BigUint *exponents, int count, int n,
+                            ModMulFn mul, const void *ctx, uint64_t *out) {
+    int bits = 0;
+    for (int k = 0; k < count; k++) {
+        int exponent_bits = biguint_bits(exponents[k]);
+        bits = exponent_bits > bits ? exponent_bits : bits;
+    }
+    if (bits == 0) {
+        for (int i = 0; i < n; i++)
+            out[i] = one[i];
+        return;
+    }
+
+    int w = pow_window_bits(bits);
+    long straus_cost = (long)count * (bits / (w + 1) + (1 << (w - 1)));
+    long pippenger_cost = -1;
+    int c = 1;
+    for (int b = 1; b <= MULTI_POW_MAX_BUCKET_BITS; b++) {
+        long cost = (long)((bits + b - 1) / b) * (count + (2L << b));
+        if (pippenger_cost < 0 || cost < pippenger_cost) {
+            pippenger_cost = cost;
+            c = b;
+        }
+    }
+
+    if (straus_cost <= pippenger_cost)
+        multi_pow_straus_limbs(bases, one, exponents, count, bits, n, mul, ctx, out);
+    else
+        multi_pow_pippenger_limbs(bases, one, exponents, count, bits, c, n, mul, ctx, out);
+}
+
+/**
+ * Montgomery
+ */
+
+// given t < 2m stored in n limbs plus an extra `top` limb, writes t mod m into out
+static void mont_final_sub(const uint64_t *t, uint64_t top, const uint64_t *m, int n, uint64_t *out) {
+    int geq = top != 0;
+    if (!geq) {
+        geq = 1;
+        for (int i = n - 1; i >= 0; i--) {
+            if (t[i] != m[i]) {
+                geq = t[i] > m[i];
+                break;
+            }
+        }
+    }
+
+    if (!geq) {
+        for (int i = 0; i < n; i++)
+            out[i] = t[i];
+        return;
+    }
+
+    uint64_t borrow = 0;
+    for (int i = 0; i < n; i++) {
+        out[i] = u64_subb(t[i], m[i], borrow, &borrow);
+    }
+}
+
+// montgomery reduction (REDC) of the 2n limbs value t, it writes t * R^(-1) mod m into out
+// note that t must have room for 2n + 1 limbs, as the last one is used to collect the carries
+static void mont_reduce(uint64_t *t, const uint64_t *m, int n, uint64_t m_inv, uint64_t *out) {
+    t[n * 2] = 0;
+    for (int i = 0; i < n; i++) {
+        // q is chosen so that t + q * m is divisible by 2^64
+        uint64_t q = t[i] * m_inv;
+        uint64_t carry = addmul_1(t + i, m, n, q);
+        for (int k = i + n; carry != 0 && k <= n * 2; k++) {
+            t[k] += carry;
+            carry = t[k] < carry;
+        }
+    }
+
+    mont_final_sub(t + n, t[n * 2], m, n, out);
+}
+
+// montgomery multiplication using the coarsely integrated operand scanning (CIOS) method
+// it writes a * b * R^(-1) mod m into out
+static void mont_mul_limbs(const uint64_t *a, const uint64_t *b, const uint64_t *m, int n, uint64_t m_inv,
+                           uint64_t *out) {
+    uint64_t t[n + 2];
+    for (int i = 0; i < n + 2; i++)
+        t[i] = 0;
+
+    for (int i = 0; i < n; i++) {
+        // t += a * b_i
+        uint64_t carry = addmul_1(t, a, n, b[i]);
+        __uint128_t sum = (__uint128_t)t[n] + carry;
+        t[n] = (uint64_t)sum;
+        t[n + 1] = (uint64_t)(sum >> 64);
+
+        // t = (t + q * m) / 2^64, the lowest limb becomes 0 and is dropped
+        uint64_t q = t[0] * m_inv;
+        carry = addmul_1(t, m, n, q);
+        sum = (__uint128_t)t[n] + carry;
+        for (int j = 1; j < n; j++)
+            t[j - 1] = t[j];
+        t[n - 1] = (uint64_t)sum;
+        t[n] = t[n + 1] + (uint64_t)(sum >> 64);
+    }
+
+    mont_final_sub(t, t[n], m, n, out);
+}
+
+void biguint_mont_ctx_init(BigUint m, BigUintMontCtx *ctx) {
+    int n = (biguint_bits(m) + 63) / 64;
+    biguint_mont_ctx_init_with_limbs(m, malloc(sizeof(uint64_t) * n * 2), ctx);
+}
+
+void biguint_mont_ctx_init_with_limbs(BigUint m, uint64_t *limbs, BigUintMontCtx *ctx) {
+    int n = (biguint_bits(m) + 63) / 64;
+    assert(n > 0 && !biguint_is_even(m));
+
+    ctx->m = biguint_new_from_limbs(n, limbs);
+    ctx->r2 = biguint_new_from_limbs(n, limbs + n);
+    for (int i = 0; i < n; i++)
+        ctx->m.limbs[i] = m.limbs[i];
+
+    // newton iteration for the inverse of m_0 mod 2^64, every step doubles the amount of correct bits
+    // the initial value m_0 is already correct for the 3 lower bits, as for every odd x: x * x = 1 (mod 8)
+    uint64_t m0 = m.limbs[0];
+    uint64_t inv = m0;
+    for (int i = 0; i < 5; i++)
+        inv *= 2 - m0 * inv;
+    ctx->m_inv = -inv;
+
+    // R^2 mod m, where R = 2^(64 * n)
+    uint64_t r2[n * 2 + 1];
+    for (int i = 0; i < n * 2; i++)
+        r2[i] = 0;
+    r2[n * 2] = 1;
+    divmod_limbs(r2, n * 2 + 1, ctx->m.limbs, n, NULL, ctx->r2.limbs);
+}
+
+void biguint_mont_ctx_free(BigUintMontCtx *ctx) {
+    // r2 shares the allocation with m
+    free(ctx->m.limbs);
+}
+
+void biguint_mont_mul(BigUint a, BigUint b, BigUintMontCtx ctx, BigUint *out) {
+    int n = ctx.m.size;
+    uint64_t x[n], y[n], result[n];
+    load_limbs(a, n, x);
+    load_limbs(b, n, y);
+    mont_mul_limbs(x, y, ctx.m.limbs, n, ctx.m_inv, result);
+    store_limbs(result, n, out);
+}
+
+void biguint_mont_sqr(BigUint a, BigUintMontCtx ctx, BigUint *out) {
+    int n = ctx.m.size;
+    uint64_t x[n], t[n * 2 + 1], result[n], scratch[mul_n_scratch_size(n) + 1];
+    load_limbs(a, n, x);
+    mul_n_limbs(x, x, n, t, scratch);
+    mont_reduce(t, ctx.m.limbs, n, ctx.m_inv, result);
+    store_limbs(result, n, out);
+}
+
+void biguint_to_mont(BigUint a, BigUintMontCtx ctx, BigUint *out) { biguint_mont_mul(a, ctx.r2, ctx, out); }
+
+void biguint_from_mont(BigUint a, BigUintMontCtx ctx, BigUint *out) {
+    int n = ctx.m.size;
+    uint64_t t[n * 2 + 1], result[n];
+    load_limbs(a, n, t);
+    for (int i = n; i < n * 2; i++)
+        t[i] = 0;
+    mont_reduce(t, ctx.m.limbs, n, ctx.m_inv, result);
+    store_limbs(result, n, out);
+}
+
+// ModMulFn for a montgomery context, squares skip the interleaved product to use the dedicated squaring
+static void mont_mod_mul(const uint64_t *a, const uint64_t *b, const void *ctx, uint64_t *out, uint64_t *scratch) {
+    const BigUintMontCtx *mont = ctx;
+    int n = mont->m.size;
+    if (a == b) {
+        mul_n_limbs(a, a, n, scratch, scratch + n * 2 + 1);
+        mont_reduce(scratch, mont->m.limbs, n, mont->m_inv, out);
+    } else {
+        mont_mul_limbs(a, b, mont->m.limbs, n, mont->m_inv, out);
+    }
+}
+
+// sliding window exponentiation in the montgomery domain, over a table of the odd powers of the base, the exponent
+// bits are read directly, so there are no divisions inside the loop
+void biguint_pow_mod_mont(BigUint a, BigUint exponent, BigUintMontCtx ctx, BigUint *out) {
+    int n = ctx.m.size;
+    const uint64_t *m = ctx.m.limbs;
+
+    // reduce the base first, as montgomery multiplication expects its inputs to be lower than m
+    uint64_t base[n], one[n], acc[n], t[n * 2 + 1];
+    BigUint base_mod = biguint_new_from_limbs(n, base);
+    biguint_mod(a, ctx.m, &base_mod);
+    mont_mul_limbs(base, ctx.r2.limbs, m, n, ctx.m_inv, base);
+
+    // one in montgomery form is R mod m
+    for (int i = 0; i < n; i++)
+        one[i] = i == 0;
+    mont_mul_limbs(one, ctx.r2.limbs, m, n, ctx.m_inv, one);
+
+    pow_window_limbs(base, one, exponent, n, mont_mod_mul, &ctx, acc);
+
+    // back from montgomery form
+    for (int i = 0; i < n; i++)
+        t[i] = acc[i];
+    for (int i = n; i < n * 2; i++)
+        t[i] = 0;
+    mont_reduce(t, m, n, ctx.m_inv, acc);
+    store_limbs(acc, n, out);
+}
+
+void biguint_multi_pow_mod_mont(const BigUint *bases, const BigUint *exponents, int count, BigUintMontCtx ctx,
+                                BigUint *out) {
+    int n = ctx.m.size;
+    const uint64_t *m = ctx.m.limbs;
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+
+    // reduced bases in montgomery form, one after the other
+    uint64_t *residues = biguint_arena_alloc(arena, (size_t)count * n);
+    for (int k = 0; k < count; k++) {
+        BigUint base = biguint_new_from_limbs(n, residues + (size_t)k * n);
+        biguint_mod(bases[k], ctx.m, &base);
+        mont_mul_limbs(base.limbs, ctx.r2.limbs, m, n, ctx.m_inv, base.limbs);
+    }
+
+    uint64_t one[n], acc[n], t[n * 2 + 1];
+    for (int i = 0; i < n; i++)
+        one[i] = i == 0;
+    mont_mul_limbs(one, ctx.r2.limbs, m, n, ctx.m_inv, one);
+
+    multi_pow_limbs(residues, one, exponents, count, n, mont_mod_mul, &ctx, acc);
+
+    for (int i = 0; i < n; i++)
+        t[i] = acc[i];
+    for (int i = n; i < n * 2; i++)
+        t[i] = 0;
+    mont_reduce(t, m, n, ctx.m_inv, acc);
+    store_limbs(acc, n, out);
+    biguint_arena_reset(arena, mark);
+}
+
+/**
+ * Barrett
+ */
+
+// computes x mod m, where x has 2k limbs
+// see algorithm 14.42 of the Handbook of Applied Cryptography
+static void barrett_reduce_limbs(const uint64_t *x, BigUintBarrettCtx ctx, uint64_t *out) {
+    int k = ctx.m.size;
+    uint64_t q2[k * 2 + 2], r2[k + 1], r[k + 1];
+
+    // q3 = floor(floor(x / b^(k - 1)) * mu / b^(k + 1)), which is at most 2 units lower than floor(x / m)
+    mul_limbs(x + k - 1, k + 1, ctx.mu.limbs, k + 1, q2, k * 2 + 2);
+    const uint64_t *q3 = q2 + k + 1;
+
+    // r = (x - q3 * m) mod b^(k + 1)
+    mul_limbs(q3, k + 1, ctx.m.limbs, k, r2, k + 1);
+    uint64_t borrow = 0;
+    for (int i = 0; i < k + 1; i++) {
+        r[i] = u64_subb(x[i], r2[i], borrow, &borrow);
+    }
+
+    // at most two subtractions are needed to bring it into [0, m)
+    while (1) {
+        int geq = r[k] != 0;
+        if (!geq) {
+            geq = 1;
+            for (int i = k - 1; i >= 0; i--) {
+                if (r[i] != ctx.m.limbs[i]) {
+                    geq = r[i] > ctx.m.limbs[i];
+                    break;
+                }
+            }
+        }
+        if (!geq)
+            break;
+
+        borrow = 0;
+        for (int i = 0; i < k + 1; i++) {
+            uint64_t m_i = i < k ? ctx.m.limbs[i] : 0;
+            r[i] = u64_subb(r[i], m_i, borrow, &borrow);
+        }
+    }
+
+    for (int i = 0; i < k; i++)
+        out[i] = r[i];
+}
+
+void biguint_barrett_ctx_init(BigUint m, BigUintBarrettCtx *ctx) {
+    int k = (biguint_bits(m) + 63) / 64;
+    biguint_barrett_ctx_init_with_limbs(m, malloc(sizeof(uint64_t) * (k * 2 + 1)), ctx);
+}
+
+void biguint_barrett_ctx_init_with_limbs(BigUint m, uint64_t *limbs, BigUintBarrettCtx *ctx) {
+    int k = (biguint_bits(m) + 63) / 64;
+    assert(k > 0);
+
+    ctx->m = biguint_new_from_limbs(k, limbs);
+    ctx->mu = biguint_new_from_limbs(k + 1, limbs + k);
+    for (int i = 0; i < k; i++)
+        ctx->m.limbs[i] = m.limbs[i];
+
+    // mu = floor(b^(2k) / m), where b = 2^64
+    uint64_t numerator[k * 2 + 1], quot[k + 2], rem[k];
+    for (int i = 0; i < k * 2; i++)
+        numerator[i] = 0;
+    numerator[k * 2] = 1;
+    divmod_limbs(numerator, k * 2 + 1, ctx->m.limbs, k, quot, rem);
+    for (int i = 0; i < k + 1; i++)
+        ctx->mu.limbs[i] = quot[i];
+
+    // when m = b^(k - 1), mu = b^(k + 1) doesn't fit in k + 1 limbs. Using b^(k + 1) - 1 instead makes q3 one unit
+    // lower at most, which is covered by the final subtractions
+    if (quot[k + 1] != 0) {
+        for (int i = 0; i < k + 1; i++)
+            ctx->mu.limbs[i] = UINT64_MAX;
+    }
+}
+
+void biguint_barrett_ctx_free(BigUintBarrettCtx *ctx) {
+    // mu shares the allocation with m
+    free(ctx->m.limbs);
+}
+
+void biguint_barrett_reduce(BigUint a, BigUintBarrettCtx ctx, BigUint *out) {
+    int k = ctx.m.size;
+    int len = (biguint_bits(a) + 63) / 64;
+    uint64_t x[k * 2], r[k];
+    for (int i = 0; i < k; i++)
+        r[i] = 0;
+
+    // values wider than 2k limbs are consumed from the top, k limbs at a time:
+    //                      r = (r * b^k + next_k_limbs) mod m
+    // since r < m, every intermediate value fits in 2k limbs
+    int pos = len > k ? len - ((len - 1) % k + 1) : 0;
+    for (int i = 0; i < k; i++)
+        x[i] = pos + i < len ? a.limbs[pos + i] : 0;
+    for (int i = k; i < k * 2; i++)
+        x[i] = 0;
+    barrett_reduce_limbs(x, ctx, r);
+
+    while (pos > 0) {
+        pos -= k;
+        for (int i = 0; i < k; i++) {
+            x[i] = a.limbs[pos + i];
+            x[k + i] = r[i];
+        }
+        barrett_reduce_limbs(x, ctx, r);
+    }
+
+    store_limbs(r, k, out);
+}
+
+void biguint_add_mod_ctx(BigUint a, BigUint b, BigUintBarrettCtx ctx, BigUint *out) {
+    int k = ctx.m.size;
+    uint64_t x[k], y[k], sum[k * 2];
+    BigUint a_mod = biguint_new_from_limbs(k, x);
+    BigUint b_mod = biguint_new_from_limbs(k, y);
+    biguint_barrett_reduce(a, ctx, &a_mod);
+    biguint_barrett_reduce(b, ctx, &b_mod);
+
+    uint64_t carry = 0;
+    for (int i = 0; i < k; i++) {
+        sum[i] = u64_addc(x[i], y[i], carry, &carry);
+    }
+    sum[k] = carry;
+    for (int i = k + 1; i < k * 2; i++)
+        sum[i] = 0;
+
+    barrett_reduce_limbs(sum, ctx, x);
+    store_limbs(x, k, out);
+}
+
+void biguint_sub_mod_ctx(BigUint a, BigUint b, BigUintBarrettCtx ctx, BigUint *out) {
+    int k = ctx.m.size;
+    uint64_t x[k], y[k];
+    BigUint a_mod = biguint_new_from_limbs(k, x);
+    BigUint b_mod = biguint_new_from_limbs(k, y);
+    biguint_barrett_reduce(a, ctx, &a_mod);
+    biguint_barrett_reduce(b, ctx, &b_mod);
+
+    // x - y, wrapping around m when y > x
+    uint64_t borrow = 0;
+    for (int i = 0; i < k; i++) {
+        x[i] = u64_subb(x[i], y[i], borrow, &borrow);
+    }
+    if (borrow) {
+        uint64_t carry = 0;
+        for (int i = 0; i < k; i++) {
+            x[i] = u64_addc(x[i], ctx.m.limbs[i], carry, &carry);
+        }
+    }
+
+    store_limbs(x, k, out);
+}
+
+void biguint_mul_mod_ctx(BigUint a, BigUint b, BigUintBarrettCtx ctx, BigUint *out) {
+    int k = ctx.m.size;
+    uint64_t x[k], y[k], product[k * 2];
+    BigUint a_mod = biguint_new_from_limbs(k, x);
+    BigUint b_mod = biguint_new_from_limbs(k, y);
+    biguint_barrett_reduce(a, ctx, &a_mod);
+    biguint_barrett_reduce(b, ctx, &b_mod);
+
+    mul_limbs(x, k, y, k, product, k * 2);
+    barrett_reduce_limbs(product, ctx, x);
+    store_limbs(x, k, out);
+}
+
+// ModMulFn for a barrett context
+static void barrett_mod_mul(const uint64_t *a, const uint64_t *b, const void *ctx, uint64_t *out, uint64_t *scratch) {
+    const BigUintBarrettCtx *barrett = ctx;
+    int k = barrett->m.size;
+    mul_n_limbs(a, b, k, scratch, scratch + k * 2 + 1);
+    barrett_reduce_limbs(scratch, *barrett, out);
+}
+
+// sliding window exponentiation with barrett reductions, over a table of the odd powers of the base
+void biguint_pow_mod_barrett(BigUint a, BigUint exponent, BigUintBarrettCtx ctx, BigUint *out) {
+    int k = ctx.m.size;
+    uint64_t base[k], one[k], acc[k], t[k * 2];
+    BigUint a_mod = biguint_new_from_limbs(k, base);
+    biguint_barrett_reduce(a, ctx, &a_mod);
+
+    for (int i = 0; i < k; i++)
+        t[i] = i == 0;
+    for (int i = k; i < k * 2; i++)
+        t[i] = 0;
+    // reducing one also handles m = 1
+    barrett_reduce_limbs(t, ctx, one);
+
+    pow_window_limbs(base, one, exponent, k, barrett_mod_mul, &ctx, acc);
+    store_limbs(acc, k, out);
+}
+
+void biguint_multi_pow_mod_barrett(const BigUint *bases, const BigUint *exponents, int count, BigUintBarrettCtx ctx,
+                                   BigUint *out) {
+    int k = ctx.m.size;
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+
+    uint64_t *residues = biguint_arena_alloc(arena, (size_t)count * k);
+    for (int i = 0; i < count; i++) {
+        BigUint base = biguint_new_from_limbs(k, residues + (size_t)i * k);
+        biguint_barrett_reduce(bases[i], ctx, &base);
+    }
+
+    uint64_t one[k], acc[k], t[k * 2];
+    for (int i = 0; i < k; i++)
+        t[i] = i == 0;
+    for (int i = k; i < k * 2; i++)
+        t[i] = 0;
+    barrett_reduce_limbs(t, ctx, one);
+
+    multi_pow_limbs(residues, one, exponents, count, k, barrett_mod_mul, &ctx, acc);
+    store_limbs(acc, k, out);
+    biguint_arena_reset(arena, mark);
+}
+
+void biguint_multi_pow_mod(const BigUint *bases, const BigUint *exponents, int count, BigUint m, BigUint *out) {
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+
+    if (!biguint_is_even(m)) {
+        BigUintMontCtx ctx;
+        biguint_mont_ctx_init_with_limbs(m, biguint_arena_alloc(arena, m.size * 2), &ctx);
+        biguint_multi_pow_mod_mont(bases, exponents, count, ctx, out);
+    } else {
+        BigUintBarrettCtx ctx;
+        biguint_barrett_ctx_init_with_limbs(m, biguint_arena_alloc(arena, m.size * 2 + 1), &ctx);
+        biguint_multi_pow_mod_barrett(bases, exponents, count, ctx, out);
+    }
+
+    biguint_arena_reset(arena, mark);
+}
+
 /**
  * Debugging
  */
@@ -0,0 +1,232 @@
+#include <arena.h>
+#include <biguint.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define IFMA_KERNELS 1
+#endif
+
+/**
+ * Batched modular exponentiation
+ *
+ * CPUs with AVX-512 IFMA multiply eight pairs of 52 bits digits per instruction (vpmadd52luq/vpmadd52huq), which maps
+ * well onto eight independent montgomery exponentiations running side by side. Operands are converted to radix 2^52
+ * and interleaved so that vector j holds digit j of every lane, each lane with its own modulus and exponent.
+ *
+ * https://eprint.iacr.org/2018/335 (Drucker and Gueron, Fast modular squaring with AVX512IFMA)
+ */
+
+#define BATCH_LANES 8
+#define DIGIT_BITS 52
+#define DIGIT_MASK ((1ULL << DIGIT_BITS) - 1)
+#define WINDOW_BITS 4
+#define WINDOW_SIZE (1 << WINDOW_BITS)
+
+static void pow_mod_batch_scalar(const BigUint *bases, const BigUint *exponents, const BigUint *moduli, BigUint *outs,
+                                 int count) {
+    for (int i = 0; i < count; i++)
+        biguint_pow_mod(bases[i], exponents[i], moduli[i], &outs[i]);
+}
+
+#ifdef IFMA_KERNELS
+
+// writes the n digits of a into the given lane of the interleaved buffer x
+static void to_digits(BigUint a, int lane, int n, uint64_t *x) {
+    for (int j = 0; j < n; j++) {
+        int bit = j * DIGIT_BITS, limb = bit / 64, shift = bit % 64;
+        uint64_t digit = limb < a.size ? a.limbs[limb] >> shift : 0;
+        if (shift > 64 - DIGIT_BITS && limb + 1 < a.size)
+            digit |= a.limbs[limb + 1] << (64 - shift);
+        x[j * BATCH_LANES + lane] = digit & DIGIT_MASK;
+    }
+}
+
+// reads the n digits in the given lane of the interleaved buffer x into out
+static void from_digits(const uint64_t *x, int lane, int n, BigUint *out) {
+    biguint_zero(out);
+    for (int j = 0; j < n; j++) {
+        uint64_t digit = x[j * BATCH_LANES + lane];
+        int bit = j * DIGIT_BITS, limb = bit / 64, shift = bit % 64;
+        if (limb < out->size)
+            out->limbs[limb] |= digit << shift;
+        if (shift > 64 - DIGIT_BITS && limb + 1 < out->size)
+            out->limbs[limb + 1] |= digit >> (64 - shift);
+    }
+}
+
+// almost montgomery multiplication of 8 lanes at once, out = a * b * 2^(-52n) mod m, with out < 2m as long as
+// a, b < 2m and 2^(52n) > 4m. Digits are accumulated unnormalized in 64 bits, which holds for n < 2^10, and only
+// normalized at the end. t is scratch space for n + 1 vectors, out may alias a or b
+__attribute__((target("avx512f,avx512ifma"))) static void ifma_mont_mul(const __m512i *a, const __m512i *b,
+                                                                           const __m512i *m, __m512i k0, int n,
+                                                                           __m512i *t, __m512i *out) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i mask = _mm512_set1_epi64(DIGIT_MASK);
+    for (int j = 0; j <= n; j++)
+        t[j] = zero;
+
+    for (int i = 0; i < n; i++) {
+        __m512i b_i = b[i];
+        for (int j = 0; j < n; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], a[j], b_i);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], a[j], b_i);
+        }
+
+        // q is chosen so that the lowest digit becomes a multiple of 2^52, which is then shifted out
+        __m512i q = _mm512_madd52lo_epu64(zero, t[0], k0);
+        for (int j = 0; j < n; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], m[j], q);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], m[j], q);
+        }
+        __m512i carry = _mm512_srli_epi64(t[0], DIGIT_BITS);
+        for (int j = 0; j < n; j++)
+            t[j] = t[j + 1];
+        t[0] = _mm512_add_epi64(t[0], carry);
+        t[n] = zero;
+    }
+
+    __m512i carry = zero;
+    for (int j = 0; j < n; j++) {
+        __m512i digit = _mm512_add_epi64(t[j], carry);
+        out[j] = _mm512_and_si512(digit, mask);
+        carry = _mm512_srli_epi64(digit, DIGIT_BITS);
+    }
+}
+
+// out = table[index] digit by digit, where every lane picks its own entry of the table
+__attribute__((target("avx512f"))) static void ifma_select(const __m512i *table, int n, __m512i index, __m512i *out) {
+    for (int j = 0; j < n; j++)
+        out[j] = _mm512_setzero_si512();
+    for (int k = 0; k < WINDOW_SIZE; k++) {
+        __mmask8 lanes = _mm512_cmpeq_epi64_mask(index, _mm512_set1_epi64(k));
+        const __m512i *entry = table + (size_t)k * n;
+        for (int j = 0; j < n; j++)
+            out[j] = _mm512_mask_mov_epi64(out[j], lanes, entry[j]);
+    }
+}
+
+// fixed window exponentiation of up to 8 lanes, all their moduli being odd and their exponents not zero
+// lanes not in use repeat lane 0, so every lane always holds a valid modulus
+__attribute__((target("avx512f,avx512ifma"))) static void ifma_pow_mod(const BigUint *bases, const BigUint *exponents,
+                                                                          const BigUint *moduli, BigUint *outs,
+                                                                          const int *indexes, int count) {
+    int n = 0, bits = 0;
+    for (int l = 0; l < count; l++) {
+        int m_digits = (biguint_bits(moduli[indexes[l]]) + 2 + DIGIT_BITS - 1) / DIGIT_BITS;
+        int e_bits = biguint_bits(exponents[indexes[l]]);
+        n = m_digits > n ? m_digits : n;
+        bits = e_bits > bits ? e_bits : bits;
+    }
+
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark mark = biguint_arena_mark(arena);
+    size_t vector = BATCH_LANES;
+    uint64_t *memory = biguint_arena_alloc(arena, vector * ((size_t)n * (WINDOW_SIZE + 6) + 1) + 8);
+    __m512i *m = (__m512i *)(((uintptr_t)memory + 63) & ~(uintptr_t)63);
+    __m512i *r2 = m + n, *one = r2 + n, *acc = one + n, *power = acc + n, *table = power + n, *t = table + n * WINDOW_SIZE;
+    uint64_t k0[BATCH_LANES];
+
+    // per lane setup: R^2 mod m where R = 2^(52n), -m^(-1) mod 2^52 and the base reduced mod m
+    int wide = (DIGIT_BITS * n * 2) / 64 + 1;
+    BigUint pow2 = biguint_arena_new(arena, wide);
+    BigUint rem = biguint_arena_new(arena, wide);
+    for (int l = 0; l < BATCH_LANES; l++) {
+        int index = indexes[l < count ? l : 0];
+        BigUint mod = moduli[index];
+
+        uint64_t m0 = mod.limbs[0], inv = m0;
+        for (int i = 0; i < 5; i++)
+            inv *= 2 - m0 * inv;
+        k0[l] = -inv & DIGIT_MASK;
+
+        biguint_zero(&pow2);
+        pow2.limbs[(DIGIT_BITS * n * 2) / 64] = 1ULL << ((DIGIT_BITS * n * 2) % 64);
+        biguint_mod(pow2, mod, &rem);
+        to_digits(rem, l, n, (uint64_t *)r2);
+        to_digits(mod, l, n, (uint64_t *)m);
+        biguint_mod(bases[index], mod, &rem);
+        to_digits(rem, l, n, (uint64_t *)power);
+
+        biguint_one(&rem);
+        to_digits(rem, l, n, (uint64_t *)one);
+    }
+    __m512i k0_vector = _mm512_loadu_si512(k0);
+
+    // table[k] = base^k in montgomery form
+    ifma_mont_mul(one, r2, m, k0_vector, n, t, table);
+    ifma_mont_mul(power, r2, m, k0_vector, n, t, table + n);
+    for (int k = 2; k < WINDOW_SIZE; k++)
+        ifma_mont_mul(table + (size_t)(k - 1) * n, table + n, m, k0_vector, n, t, table + (size_t)k * n);
+
+    int windows = (bits + WINDOW_BITS - 1) / WINDOW_BITS;
+    for (int w = windows - 1; w >= 0; w--) {
+        uint64_t index[BATCH_LANES];
+        for (int l = 0; l < BATCH_LANES; l++) {
+            BigUint exponent = exponents[indexes[l < count ? l : 0]];
+            index[l] = 0;
+            for (int b = WINDOW_BITS - 1; b >= 0; b--) {
+                int bit = w * WINDOW_BITS + b;
+                int set = bit / 64 < exponent.size && ((exponent.limbs[bit / 64] >> (bit % 64)) & 1);
+                index[l] = (index[l] << 1) | set;
+            }
+        }
+
+        ifma_select(table, n, _mm512_loadu_si512(index), power);
+        if (w == windows - 1) {
+            for (int j = 0; j < n; j++)
+                acc[j] = power[j];
+            continue;
+        }
+        for (int s = 0; s < WINDOW_BITS; s++)
+            ifma_mont_mul(acc, acc, m, k0_vector, n, t, acc);
+        ifma_mont_mul(acc, power, m, k0_vector, n, t, acc);
+    }
+
+    // leave the montgomery domain, the result is at most m, which only happens when the base is a multiple of m
+    ifma_mont_mul(acc, one, m, k0_vector, n, t, acc);
+    for (int l = 0; l < count; l++) {
+        BigUint *out = &outs[indexes[l]];
+        BigUint mod = moduli[indexes[l]];
+        from_digits((uint64_t *)acc, l, n, &rem);
+        if (biguint_cmp(rem, mod) >= 0)
+            biguint_sub(rem, mod, &rem);
+        biguint_cpy(out, rem);
+    }
+
+    biguint_arena_reset(arena, mark);
+}
+
+static int ifma_supported() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+}
+
+#endif
+
+void biguint_pow_mod_batch(const BigUint *bases, const BigUint *exponents, const BigUint *moduli, BigUint *outs,
+                           int count) {
+#ifdef IFMA_KERNELS
+    if (!biguint_asm_kernels() || !ifma_supported()) {
+        pow_mod_batch_scalar(bases, exponents, moduli, outs, count);
+        return;
+    }
+
+    // odd moduli are gathered into groups of 8 lanes, even ones (and zero exponents) go through the scalar path
+    int lanes[BATCH_LANES], used = 0;
+    for (int i = 0; i < count; i++) {
+        if (biguint_is_even(moduli[i]) || biguint_is_zero(exponents[i])) {
+            biguint_pow_mod(bases[i], exponents[i], moduli[i], &outs[i]);
+            continue;
+        }
+        lanes[used++] = i;
+        if (used == BATCH_LANES) {
+            ifma_pow_mod(bases, exponents, moduli, outs, lanes, used);
+            used = 0;
+        }
+    }
+    if (used > 0)
+        ifma_pow_mod(bases, exponents, moduli, outs, lanes, used);
+#else
+    pow_mod_batch_scalar(bases, exponents, moduli, outs, count);
+#endif
+}
@@ -0,0 +1,144 @@
+#include <primitive-types/arena.h>
+#include <utils/test.h>
+
+void test_biguint_arena_new_is_zeroed() {
+    BigUintArena arena;
+    biguint_arena_init(&arena, 16);
+
+    BigUint a = biguint_arena_new(&arena, 4);
+    for (int i = 0; i < 4; i++)
+        a.limbs[i] = UINT64_MAX;
+
+    BigUintArenaMark mark = biguint_arena_mark(&arena);
+    biguint_arena_alloc(&arena, 4)[0] = UINT64_MAX;
+    biguint_arena_reset(&arena, mark);
+
+    BigUint b = biguint_arena_new(&arena, 4);
+    assert_that(b.size == 4);
+    assert_that(biguint_is_zero(b));
+    assert_that(a.limbs[3] == UINT64_MAX);
+
+    biguint_arena_free(&arena);
+}
+
+void test_biguint_arena_reset_reuses_memory() {
+    BigUintArena arena;
+    biguint_arena_init(&arena, 16);
+
+    BigUintArenaMark mark = biguint_arena_mark(&arena);
+    uint64_t *first = biguint_arena_alloc(&arena, 8);
+    biguint_arena_reset(&arena, mark);
+    uint64_t *second = biguint_arena_alloc(&arena, 8);
+
+    assert_that(first == second);
+
+    biguint_arena_free(&arena);
+}
+
+void test_biguint_arena_grow_keeps_allocations() {
+    BigUintArena arena;
+    biguint_arena_init(&arena, 16);
+
+    BigUint a = biguint_arena_new(&arena, 12);
+    biguint_from_u64(1337, &a);
+
+    BigUintArenaMark mark = biguint_arena_mark(&arena);
+    // does not fit in the first block
+    uint64_t *large = biguint_arena_alloc(&arena, 100);
+    for (int i = 0; i < 100; i++)
+        large[i] = i;
+    assert_that(a.limbs[0] == 1337);
+    assert_that(large[99] == 99);
+
+    // once grown, the same workload is served from the blocks already there
+    biguint_arena_reset(&arena, mark);
+    assert_that(biguint_arena_alloc(&arena, 100) == large);
+
+    biguint_arena_free(&arena);
+}
+
+void test_biguint_scratch_is_balanced() {
+    BigUintArena *arena = biguint_scratch();
+    BigUintArenaMark before = biguint_arena_mark(arena);
+
+    BigUint a = biguint_new(8);
+    BigUint b = biguint_new(8);
+    BigUint out = biguint_new(8);
+    biguint_from_dec_string("123456789012345678901234567890", &a);
+    biguint_from_dec_string("987654321098765432109876543210", &b);
+    biguint_mul_mod(a, b, a, &out);
+    biguint_shl(a, 65, &out);
+    char *str = biguint_to_dec_string(a);
+    free(str);
+
+    BigUintArenaMark after = biguint_arena_mark(arena);
+    assert_that(before.block == after.block);
+    assert_that(before.top == after.top);
+}
+
+void test_biguint_arena_free_twice() {
+    BigUintArena arena;
+    biguint_arena_init(&arena, 16);
+    biguint_arena_alloc(&arena, 100);
+
+    biguint_arena_free(&arena);
+    assert_that(arena.current == NULL);
+    biguint_arena_free(&arena);
+    assert_that(arena.current == NULL);
+}
+
+// number of limbs the arena holds across all its blocks
+static size_t arena_capacity(BigUintArena *arena) {
+    BigUintArenaBlock *block = arena->current;
+    while (block->prev != NULL)
+        block = block->prev;
+    size_t capacity = 0;
+    for (; block != NULL; block = block->next)
+        capacity += block->capacity;
+    return capacity;
+}
+
+void test_biguint_pow_mod_does_not_grow_scratch() {
+    // large enough for the context and the power table to outgrow the first block
+    int n = 512;
+    BigUint base = biguint_new_heap(n);
+    BigUint exponent = biguint_new_with_limbs(2, {0x123456789abcdefULL, 0xfedcba987654321ULL});
+    BigUint m = biguint_new_heap(n);
+    BigUint out = biguint_new_heap(n);
+    for (int i = 0; i < n; i++) {
+        base.limbs[i] = i * 0x9e3779b97f4a7c15ULL;
+        m.limbs[i] = ~(i * 0x2545f4914f6cdd1dULL);
+    }
+
+    BigUintArena *arena = biguint_scratch();
+    for (int odd = 0; odd < 2; odd++) {
+        m.limbs[0] = odd ? m.limbs[0] | 1 : m.limbs[0] & ~1ULL;
+
+        biguint_pow_mod(base, exponent, m, &out);
+        BigUintArenaMark before = biguint_arena_mark(arena);
+        size_t capacity = arena_capacity(arena);
+
+        for (int i = 0; i < 4; i++)
+            biguint_pow_mod(base, exponent, m, &out);
+
+        BigUintArenaMark after = biguint_arena_mark(arena);
+        assert_that(arena_capacity(arena) == capacity);
+        assert_that(before.block == after.block);
+        assert_that(before.top == after.top);
+    }
+
+    biguint_free(&base, &m, &out);
+}
+
+int main() {
+    BEGIN_TEST();
+    test(test_biguint_arena_new_is_zeroed);
+    test(test_biguint_arena_reset_reuses_memory);
+    test(test_biguint_arena_grow_keeps_allocations);
+    test(test_biguint_scratch_is_balanced);
+    test(test_biguint_arena_free_twice);
+    test(test_biguint_pow_mod_does_not_grow_scratch);
+    END_TEST();
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <primitive-types/bigint.h>
+#include <utils/test.h>
+
+static BigInt bigint_from_i64(int64_t value, BigInt out) {
+    biguint_zero(&out.mag);
+    out.mag.limbs[0] = value < 0 ? -(uint64_t)value : (uint64_t)value;
+    out.sign = value < 0 ? -1 : 1;
+    return out;
+}
+
+void test_bigint_add_sub() {
+    int64_t values[] = {0, 1, -1, 7, -7, 123456789, -987654321};
+    BigInt result = bigint_new(2), expected = bigint_new(2);
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 7; j++) {
+            BigInt a = bigint_from_i64(values[i], bigint_new(2));
+            BigInt b = bigint_from_i64(values[j], bigint_new(2));
+
+            bigint_add(a, b, &result);
+            assert_that(bigint_cmp(result, bigint_from_i64(values[i] + values[j], expected)) == 0);
+
+            bigint_sub(a, b, &result);
+            assert_that(bigint_cmp(result, bigint_from_i64(values[i] - values[j], expected)) == 0);
+
+            // in place
+            bigint_sub(a, b, &a);
+            assert_that(bigint_cmp(a, result) == 0);
+        }
+    }
+}
+
+void test_bigint_mul() {
+    BigInt a = bigint_from_i64(-12, bigint_new(2));
+    BigInt b = bigint_from_i64(5, bigint_new(2));
+    BigInt result = bigint_new(2);
+
+    bigint_mul(a, b, &result);
+    assert_that(bigint_cmp(result, bigint_from_i64(-60, bigint_new(2))) == 0);
+
+    bigint_mul(a, a, &result);
+    assert_that(bigint_cmp(result, bigint_from_i64(144, bigint_new(2))) == 0);
+
+    // zero is positive whatever the signs of the operands
+    bigint_mul(a, bigint_new(2), &result);
+    assert_that(bigint_is_zero(result) && result.sign == 1);
+}
+
+void test_bigint_cmp() {
+    assert_that(bigint_cmp(bigint_from_i64(-5, bigint_new(1)), bigint_from_i64(3, bigint_new(1))) < 0);
+    assert_that(bigint_cmp(bigint_from_i64(-5, bigint_new(1)), bigint_from_i64(-3, bigint_new(1))) < 0);
+    assert_that(bigint_cmp(bigint_from_i64(5, bigint_new(1)), bigint_from_i64(3, bigint_new(1))) > 0);
+
+    BigInt minus_zero = bigint_new(1);
+    minus_zero.sign = -1;
+    assert_that(bigint_cmp(minus_zero, bigint_new(1)) == 0);
+}
+
+void test_bigint_mod() {
+    BigUint m = biguint_new_with_limbs(1, {11});
+    BigUint result = biguint_new(1);
+
+    bigint_mod(bigint_from_i64(-3, bigint_new(1)), m, &result);
+    assert_that(result.limbs[0] == 8);
+
+    bigint_mod(bigint_from_i64(-22, bigint_new(1)), m, &result);
+    assert_that(result.limbs[0] == 0);
+
+    bigint_mod(bigint_from_i64(25, bigint_new(1)), m, &result);
+    assert_that(result.limbs[0] == 3);
+}
+
+int main() {
+    BEGIN_TEST();
+    test(test_bigint_add_sub);
+    test(test_bigint_mul);
+    test(test_bigint_cmp);
+    test(test_bigint_mod);
+    END_TEST();
+
+    return 0;
+}
@@ -14,6 +14,38 @@ void test_biguint_overflow_add() {
     assert_that(overflow == 0);
 }
 
+void test_biguint_overflow_add_different_sizes() {
+    BigUint first = biguint_new_with_limbs(2, {UINT64_MAX, 5});
+    BigUint second = biguint_new_with_limbs(8, {1, 0, 0, 0, 0, 0, 0, 0});
+    BigUint result = biguint_new_with_limbs(4, {9, 9, 9, 9});
+    BigUint expected_result = biguint_new_with_limbs(4, {0, 6, 0, 0});
+
+    int overflow = biguint_overflow_add(first, second, &result);
+
+    assert_that(biguint_cmp(result, expected_result) == 0);
+    assert_that(overflow == 0);
+}
+
+void test_biguint_len() {
+    BigUint value = biguint_new_with_limbs(8, {1, 0, 7, 0, 0, 0, 0, 0});
+    BigUint zero = biguint_new_with_limbs(8, {0});
+
+    assert_that(biguint_len(value) == 3);
+    assert_that(biguint_len(zero) == 0);
+    assert_that(biguint_bits(value) == 131);
+    assert_that(biguint_bits(zero) == 0);
+}
+
+void test_biguint_cmp_different_sizes() {
+    BigUint small = biguint_new_with_limbs(2, {UINT64_MAX, UINT64_MAX});
+    BigUint large = biguint_new_with_limbs(4, {0, 0, 1, 0});
+    BigUint padded = biguint_new_with_limbs(4, {UINT64_MAX, UINT64_MAX, 0, 0});
+
+    assert_that(biguint_cmp(small, large) == -1);
+    assert_that(biguint_cmp(large, small) == 1);
+    assert_that(biguint_cmp(small, padded) == 0);
+}
+
 void test_biguint_overflow_add_with_overflow() {
     BigUint first = biguint_new_with_limbs(4, {UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX});
     BigUint second = biguint_new_with_limbs(4, {UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX});
@@ -58,6 +90,18 @@ void test_biguint_overflow_sub_with_overflow() {
     assert_that(overflow == 1);
 }
 
+void test_biguint_overflow_sub_truncated() {
+    BigUint first = biguint_new_with_limbs(4, {0, 0, 2, 0});
+    BigUint second = biguint_new_with_limbs(4, {1, 0, 0, 0});
+    BigUint result = biguint_new_with_limbs(2, {9, 9});
+    BigUint expected_result = biguint_new_with_limbs(2, {UINT64_MAX, UINT64_MAX});
+
+    int overflow = biguint_overflow_sub(first, second, &result);
+
+    assert_that(biguint_cmp(result, expected_result) == 0);
+    assert_that(overflow == 1);
+}
+
 void test_biguint_sub_mod() {
     BigUint first = biguint_new_with_limbs(4, {0, 0, 0, 0});
     BigUint second = biguint_new_with_limbs(4, {1, 1, 1, 1});
@@ -90,6 +134,168 @@ void test_biguint_overflow_mul_with_overflow() {
     assert_that(overflow == 1);
 }
 
+void test_biguint_mul_karatsuba() {
+    BigUint first = biguint_new(40);
+    BigUint second = biguint_new(37);
+    BigUint expected_result = biguint_new(77);
+    BigUint result = biguint_new(77);
+    for (int i = 0; i < first.size; i++)
+        first.limbs[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+    for (int i = 0; i < second.size; i++)
+        second.limbs[i] = ~0ULL - i;
+
+    int threshold = biguint_karatsuba_threshold();
+    biguint_set_karatsuba_threshold(1000);
+    biguint_mul(first, second, &expected_result);
+    biguint_set_karatsuba_threshold(4);
+    biguint_mul(first, second, &result);
+    biguint_set_karatsuba_threshold(threshold);
+
+    assert_that(biguint_cmp(result, expected_result) == 0);
+}
+
+void test_biguint_mul_toom3() {
+    BigUint first = biguint_new(100);
+    BigUint second = biguint_new(100);
+    BigUint expected_result = biguint_new(200);
+    BigUint result = biguint_new(200);
+    for (int i = 0; i < first.size; i++)
+        first.limbs[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+    for (int i = 0; i < second.size; i++)
+        second.limbs[i] = ~0ULL - i;
+
+    int karatsuba_threshold = biguint_karatsuba_threshold();
+    int toom3_threshold = biguint_toom3_threshold();
+    biguint_set_karatsuba_threshold(1000);
+    biguint_set_toom3_threshold(1000);
+    biguint_mul(first, second, &expected_result);
+    biguint_set_karatsuba_threshold(8);
+    biguint_set_toom3_threshold(9);
+    biguint_mul(first, second, &result);
+    assert_that(biguint_cmp(result, expected_result) == 0);
+
+    biguint_set_karatsuba_threshold(1000);
+    biguint_set_toom3_threshold(1000);
+    biguint_mul(second, second, &expected_result);
+    biguint_set_karatsuba_threshold(8);
+    biguint_set_toom3_threshold(9);
+    biguint_mul(second, second, &result);
+    assert_that(biguint_cmp(result, expected_result) == 0);
+
+    biguint_set_karatsuba_threshold(karatsuba_threshold);
+    biguint_set_toom3_threshold(toom3_threshold);
+}
+
+void test_biguint_mul_ntt() {
+    BigUint first = biguint_new(150);
+    BigUint second = biguint_new(90);
+    BigUint expected_result = biguint_new(240);
+    BigUint result = biguint_new(240);
+    for (int i = 0; i < first.size; i++)
+        first.limbs[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+    for (int i = 0; i < second.size; i++)
+        second.limbs[i] = ~0ULL - i;
+
+    int ntt_threshold = biguint_ntt_threshold();
+    int ntt_threads = biguint_ntt_threads();
+    biguint_mul(first, second, &expected_result);
+    biguint_set_ntt_threshold(16);
+    biguint_set_ntt_threads(3);
+    biguint_mul(first, second, &result);
+    assert_that(biguint_cmp(result, expected_result) == 0);
+
+    biguint_set_ntt_threshold(ntt_threshold);
+    biguint_mul(first, first, &expected_result);
+    biguint_set_ntt_threshold(16);
+    biguint_set_ntt_threads(1);
+    biguint_mul(first, first, &result);
+    assert_that(biguint_cmp(result, expected_result) == 0);
+
+    biguint_set_ntt_threshold(ntt_threshold);
+    biguint_set_ntt_threads(ntt_threads);
+}
+
+// runs the same operations on the assembly kernels (when the cpu supports them) and on the portable ones
+void test_biguint_mul_asm_kernels() {
+    BigUint a = biguint_new_with_limbs(8, {11400714819323198485ULL, 4354685564936845354ULL, 15755400384260043839ULL,
+                                           8709371129873690708ULL, 1663341875487337577ULL, 13064056694810536062ULL,
+                                           6018027440424182931ULL, 17418742259747381416ULL});
+    BigUint b = biguint_new_with_limbs(8, {5194913953271955949ULL, 777637246459424060ULL, 14807104613356443787ULL,
+                                           10389827906543911898ULL, 5972551199731380009ULL, 1555274492918848120ULL,
+                                           15584741859815867847ULL, 11167465153003335958ULL});
+    BigUint m = biguint_new_with_limbs(8, {11267115505749874127ULL, 12876703435142713288ULL, 14486291364535552449ULL,
+                                           16095879293928391610ULL, 17705467223321230771ULL, 868311079004518316ULL,
+                                           2477899008397357477ULL, 4087486937790196638ULL});
+    BigUint expected_mul = biguint_new_with_limbs(
+        16, {16188282369887089777ULL, 14129171786054497279ULL, 3591650658475648665ULL, 2105776756094060747ULL,
+             993788415173608066ULL, 1190114632062653000ULL, 8824098356381513878ULL, 8171948670007712109ULL,
+             15523446030603197700ULL, 4568364173629012622ULL, 13063004963323736246ULL, 4503293878077622222ULL,
+             6541009334293025545ULL, 18241722335621583837ULL, 13474071365814579033ULL, 10545123649875508045ULL});
+    BigUint expected_sqr = biguint_new_with_limbs(
+        16, {16088033396387240377ULL, 16057930618806659788ULL, 242324679385454771ULL, 10222022302606770447ULL,
+             9436168353178700119ULL, 16664139916937991939ULL, 18146511497239136181ULL, 14215916106209329382ULL,
+             15122976365295112500ULL, 13096368255545933082ULL, 5747455136910254188ULL, 8891666133957925948ULL,
+             1693620532927859807ULL, 2267429395402410847ULL, 7981777772241877579ULL, 16448029023394723064ULL});
+    BigUint expected_pow = biguint_new_with_limbs(
+        8, {14044457527504666410ULL, 12960332544256004607ULL, 14370238879020148995ULL, 2312403191696093727ULL,
+            12776319139669531553ULL, 17652119399397512451ULL, 11989366506947201973ULL, 2760097842701794897ULL});
+
+    int enabled = biguint_asm_kernels();
+    for (int asm_kernels = 1; asm_kernels >= 0; asm_kernels--) {
+        biguint_set_asm_kernels(asm_kernels);
+        BigUint product = biguint_new(16);
+        BigUint square = biguint_new(16);
+        BigUint power = biguint_new(8);
+
+        biguint_mul(a, b, &product);
+        biguint_sqr(a, &square);
+        biguint_pow_mod(a, b, m, &power);
+
+        assert_that(biguint_cmp(product, expected_mul) == 0);
+        assert_that(biguint_cmp(square, expected_sqr) == 0);
+        assert_that(biguint_cmp(power, expected_pow) == 0);
+    }
+    biguint_set_asm_kernels(enabled);
+}
+
+void test_biguint_mul_low() {
+    BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL,
+                                               18446744073709551615ULL, 18446744073709551615ULL});
+    BigUint expected_result = biguint_new_with_limbs(4, {1, 0, 0, 0});
+    biguint_mul_low(first, first, &first);
+
+    assert_that(biguint_cmp(first, expected_result) == 0);
+}
+
+void test_biguint_overflow_sqr() {
+    BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
+    BigUint expected_result =
+        biguint_new_with_limbs(4, {1, 0, 18446741874686296064ULL, 18446744073709551615ULL});
+    int overflow = biguint_overflow_sqr(first, &first);
+
+    assert_that(biguint_cmp(first, expected_result) == 0);
+    assert_that(overflow == 1);
+}
+
+void test_biguint_sqr_small() {
+    // below the karatsuba threshold squares go through the dedicated schoolbook squaring
+    uint64_t limbs[32], copy[32], square_limbs[64], product_limbs[64];
+    for (int i = 0; i < 32; i++)
+        limbs[i] = copy[i] = UINT64_MAX - i * 0x9e3779b97f4a7c15ULL;
+
+    for (int n = 1; n <= 32; n++) {
+        BigUint a = biguint_new_from_limbs(n, limbs);
+        BigUint b = biguint_new_from_limbs(n, copy);
+        BigUint square = biguint_new_from_limbs(n * 2, square_limbs);
+        BigUint product = biguint_new_from_limbs(n * 2, product_limbs);
+
+        biguint_sqr(a, &square);
+        biguint_mul(a, b, &product);
+
+        assert_that(biguint_cmp(square, product) == 0);
+    }
+}
+
 void test_biguint_mul_mod() {
     BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
     BigUint second = biguint_new_with_limbs(4, {2919980651337220095ULL, 14019525496019259228ULL, 10995116277ULL, 0});
@@ -101,6 +307,26 @@ void test_biguint_mul_mod() {
     assert_that(biguint_cmp(first, expected_result) == 0);
 }
 
+void test_biguint_mul_mod_ws() {
+    // operands wider than the modulus and above it, against the product reduced after
+    BigUint first = biguint_new_with_limbs(5, {0x0123456789ABCDEFULL, ~0ULL, 0xDEADBEEFULL, ~0ULL, 7});
+    BigUint second = biguint_new_with_limbs(4, {~0ULL, 0x8000000000000000ULL, 0, ~0ULL});
+    BigUint mod = biguint_new_with_limbs(3, {0xFFFFFFFEFFFFFC2FULL, ~0ULL, 0x00000000FFFFFFFFULL});
+    BigUint expected_result = biguint_new(3);
+    biguint_mul_mod(first, second, mod, &expected_result);
+
+    uint64_t ws[biguint_mul_mod_ws_size(3)];
+    BigUint result = biguint_new(3);
+    biguint_mul_mod_ws(first, second, mod, &result, ws);
+    assert_that(biguint_cmp(result, expected_result) == 0);
+
+    // single limb modulus
+    BigUint small_mod = biguint_new_with_limbs(1, {1000000007});
+    biguint_mul_mod(first, second, small_mod, &expected_result);
+    biguint_mul_mod_ws(first, second, small_mod, &result, ws);
+    assert_that(biguint_cmp(result, expected_result) == 0);
+}
+
 void test_biguint_overflow_pow() {
     BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 0, 0, 0});
     BigUint second = biguint_new_with_limbs(4, {2, 0, 0, 0});
@@ -133,6 +359,180 @@ void test_biguint_overflow_pow_mod() {
     assert_that(biguint_cmp(first, expected_result) == 0);
 }
 
+void test_biguint_pow_mod_even_modulus() {
+    BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
+    BigUint exp = biguint_new_with_limbs(4, {678, 12345, 0, 0});
+    BigUint mod = biguint_new_with_limbs(4, {987654322, 123456789, 4611686018427387904ULL, 0});
+    BigUint expected_result =
+        biguint_new_with_limbs(4, {13852636073679772831ULL, 5661542400942948206ULL, 3003938990113763668ULL, 0});
+    biguint_pow_mod(first, exp, mod, &first);
+
+    assert_that(biguint_cmp(first, expected_result) == 0);
+}
+
+void test_biguint_pow_mod_long_exponent() {
+    // 2^255 - 19 is prime, so by Fermat's little theorem a^(p - 1) = 1 (mod p)
+    BigUint mod = biguint_new_with_limbs(4, {18446744073709551597ULL, 18446744073709551615ULL,
+                                             18446744073709551615ULL, 9223372036854775807ULL});
+    BigUint exp = biguint_new_with_limbs(4, {18446744073709551596ULL, 18446744073709551615ULL,
+                                             18446744073709551615ULL, 9223372036854775807ULL});
+    BigUint first = biguint_new_with_limbs(4, {2919980651337220095ULL, 14019525496019259228ULL, 10995116277ULL, 0});
+    BigUint expected_result = biguint_new_with_limbs(4, {1, 0, 0, 0});
+    biguint_pow_mod(first, exp, mod, &first);
+
+    assert_that(biguint_cmp(first, expected_result) == 0);
+}
+
+void test_biguint_multi_pow_mod_inner(int count, int exponent_size, uint64_t modulus_low) {
+    BigUint *bases = malloc(sizeof(BigUint) * count);
+    BigUint *exponents = malloc(sizeof(BigUint) * count);
+    BigUint mod = biguint_new_with_limbs(4, {modulus_low, 123456789, 4611686018427387904ULL, 77});
+    BigUint expected = biguint_new_with_limbs(4, {1, 0, 0, 0});
+    BigUint power = biguint_new(4);
+    BigUint result = biguint_new(4);
+    uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < count; i++) {
+        bases[i] = biguint_new_heap(5);
+        exponents[i] = biguint_new_heap(exponent_size);
+        for (int j = 0; j < 5; j++) {
+            state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+            bases[i].limbs[j] = state;
+            if (j < exponent_size)
+                exponents[i].limbs[j] = state * 0x9E3779B97F4A7C15ULL;
+        }
+        biguint_pow_mod(bases[i], exponents[i], mod, &power);
+        biguint_mul_mod(expected, power, mod, &expected);
+    }
+
+    biguint_multi_pow_mod(bases, exponents, count, mod, &result);
+    assert_that(biguint_cmp(result, expected) == 0);
+
+    for (int i = 0; i < count; i++) {
+        biguint_free(&bases[i], &exponents[i]);
+    }
+    free(bases);
+    free(exponents);
+}
+
+void test_biguint_multi_pow_mod() {
+    // a couple of bases go through interleaved sliding windows, hundreds of them with short exponents through buckets
+    test_biguint_multi_pow_mod_inner(2, 4, 987654321);
+    test_biguint_multi_pow_mod_inner(2, 4, 987654322);
+    test_biguint_multi_pow_mod_inner(400, 1, 987654321);
+    test_biguint_multi_pow_mod_inner(400, 1, 987654322);
+    test_biguint_multi_pow_mod_inner(0, 1, 987654321);
+}
+
+void test_biguint_pow_mod_batch() {
+    // more elements than lanes, with mixed sizes, an even modulus, a zero exponent and a base equal to its modulus
+    int count = 11;
+    BigUint bases[11], exponents[11], moduli[11], outs[11], expected[11];
+    uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < count; i++) {
+        int size = 1 + (i * 5) % 17;
+        bases[i] = biguint_new_heap(size);
+        exponents[i] = biguint_new_heap(size);
+        moduli[i] = biguint_new_heap(size);
+        outs[i] = biguint_new_heap(size);
+        expected[i] = biguint_new_heap(size);
+        for (int j = 0; j < size; j++) {
+            state ^= state << 13, state ^= state >> 7, state ^= state << 17;
+            bases[i].limbs[j] = state;
+            exponents[i].limbs[j] = state * 0x9E3779B97F4A7C15ULL;
+            moduli[i].limbs[j] = state ^ 0xD1B54A32D192ED03ULL;
+        }
+        moduli[i].limbs[0] |= 1;
+    }
+    moduli[3].limbs[0] ^= 1;
+    biguint_zero(&exponents[5]);
+    biguint_cpy(&bases[7], moduli[7]);
+
+    for (int i = 0; i < count; i++)
+        biguint_pow_mod(bases[i], exponents[i], moduli[i], &expected[i]);
+
+    int enabled = biguint_asm_kernels();
+    for (int asm_kernels = 1; asm_kernels >= 0; asm_kernels--) {
+        biguint_set_asm_kernels(asm_kernels);
+        biguint_pow_mod_batch(bases, exponents, moduli, outs, count);
+        for (int i = 0; i < count; i++)
+            assert_that(biguint_cmp(outs[i], expected[i]) == 0);
+    }
+    biguint_set_asm_kernels(enabled);
+
+    for (int i = 0; i < count; i++) {
+        biguint_free(&bases[i], &exponents[i], &moduli[i], &outs[i], &expected[i]);
+    }
+}
+
+void test_biguint_mont_mul() {
+    BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
+    BigUint second = biguint_new_with_limbs(4, {2919980651337220095ULL, 14019525496019259228ULL, 10995116277ULL, 0});
+    BigUint mod = biguint_new_with_limbs(4, {987654321, 123456789, 4611686018427387904ULL, 0});
+    BigUint expected_result =
+        biguint_new_with_limbs(4, {13179553583055864730ULL, 2842543797811993826ULL, 1083742514747148870ULL, 0});
+
+    BigUintMontCtx ctx;
+    biguint_mont_ctx_init(mod, &ctx);
+    biguint_to_mont(first, ctx, &first);
+    biguint_to_mont(second, ctx, &second);
+    biguint_mont_mul(first, second, ctx, &first);
+    biguint_from_mont(first, ctx, &first);
+    biguint_mont_ctx_free(&ctx);
+
+    assert_that(biguint_cmp(first, expected_result) == 0);
+}
+
+void test_biguint_mont_sqr() {
+    BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
+    BigUint mod = biguint_new_with_limbs(4, {987654321, 123456789, 4611686018427387904ULL, 0});
+    BigUint expected_result =
+        biguint_new_with_limbs(4, {1247426682725230770ULL, 7073311727427512360ULL, 4611424911749808994ULL, 0});
+
+    BigUintMontCtx ctx;
+    biguint_mont_ctx_init(mod, &ctx);
+    biguint_to_mont(first, ctx, &first);
+    biguint_mont_sqr(first, ctx, &first);
+    biguint_from_mont(first, ctx, &first);
+    biguint_mont_ctx_free(&ctx);
+
+    assert_that(biguint_cmp(first, expected_result) == 0);
+}
+
+void test_biguint_barrett_reduce() {
+    BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
+    BigUint mod = biguint_new_with_limbs(4, {987654322, 123456789, 0, 0});
+    BigUint expected_result = biguint_new_with_limbs(4, {10281173066036391467ULL, 59194265, 0, 0});
+
+    BigUintBarrettCtx ctx;
+    biguint_barrett_ctx_init(mod, &ctx);
+    biguint_barrett_reduce(first, ctx, &first);
+    biguint_barrett_ctx_free(&ctx);
+
+    assert_that(biguint_cmp(first, expected_result) == 0);
+}
+
+void test_biguint_mod_ctx() {
+    BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
+    BigUint second = biguint_new_with_limbs(4, {2919980651337220095ULL, 14019525496019259228ULL, 10995116277ULL, 0});
+    BigUint mod = biguint_new_with_limbs(4, {987654322, 123456789, 0, 0});
+    BigUint expected_add = biguint_new_with_limbs(4, {575712037549693504ULL, 106699788, 0, 0});
+    BigUint expected_sub = biguint_new_with_limbs(4, {16906854053883668124ULL, 111768045, 0, 0});
+    BigUint expected_mul = biguint_new_with_limbs(4, {14329946047978906983ULL, 105855889, 0, 0});
+    BigUint result = biguint_new(4);
+
+    BigUintBarrettCtx ctx;
+    biguint_barrett_ctx_init(mod, &ctx);
+
+    biguint_add_mod_ctx(first, second, ctx, &result);
+    assert_that(biguint_cmp(result, expected_add) == 0);
+    biguint_sub_mod_ctx(second, first, ctx, &result);
+    assert_that(biguint_cmp(result, expected_sub) == 0);
+    biguint_mul_mod_ctx(first, second, ctx, &result);
+    assert_that(biguint_cmp(result, expected_mul) == 0);
+
+    biguint_barrett_ctx_free(&ctx);
+}
+
 void test_biguint_bitand() {
     BigUint first =
         biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 1ULL});
@@ -190,6 +590,15 @@ void test_biguint_shr() {
     assert_that(biguint_cmp(first, expected_result) == 0);
 }
 
+void test_biguint_shl_into_other() {
+    BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
+    BigUint result = biguint_new_with_limbs(4, {1, 2, 3, 4});
+    BigUint expected_result = biguint_new_with_limbs(4, {0, 18446744073709551600ULL, 18446744073709551615ULL, 17592186044415ULL});
+    biguint_shl(first, 68, &result);
+
+    assert_that(biguint_cmp(result, expected_result) == 0);
+}
+
 void test_biguint_divmod_with_rem() {
     BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
     BigUint second = biguint_new_with_limbs(4, {2919980651337220095ULL, 14019525496019259228ULL, 10995116277ULL, 0});
@@ -217,6 +626,53 @@ void test_biguint_divmod_without_rem() {
     assert_that(biguint_cmp(rem, expected_rem) == 0);
 }
 
+void test_biguint_divmod_multi_limb_divisor() {
+    BigUint first = biguint_new_with_limbs(
+        8, {17485029721327973432ULL, 7283207964119141687ULL, 890727360438182992ULL, 15149836622520594227ULL,
+            1736392818365009963ULL, 10750541312280087032ULL, 16781078052021535861ULL, 966915281866485ULL});
+    BigUint second = biguint_new_with_limbs(8, {1585446675937841368ULL, 7713914763314685786ULL, 2390146, 0, 0, 0, 0, 0});
+    BigUint quot = biguint_new(8);
+    BigUint expected_quot =
+        biguint_new_with_limbs(8, {13248383666528155711ULL, 1207003612215466348ULL, 1205020446820828998ULL,
+                                   10487451380010085792ULL, 2510517441061691985ULL, 404542280, 0, 0});
+    BigUint expected_rem =
+        biguint_new_with_limbs(8, {18209198829773688592ULL, 7906018732245362588ULL, 647729, 0, 0, 0, 0, 0});
+    biguint_divmod(first, second, &quot, &first);
+
+    assert_that(biguint_cmp(quot, expected_quot) == 0);
+    assert_that(biguint_cmp(first, expected_rem) == 0);
+}
+
+void test_biguint_divmod_large_dividend() {
+    // the normalized dividend alone is larger than a default 8 MB stack
+    int n = (1 << 20) + 3;
+    BigUint first = biguint_new_heap(n);
+    BigUint second = biguint_new_with_limbs(3, {9020433235620117913ULL, 2203045184387934019ULL, 7713914763314685786ULL});
+    uint64_t seed = 88172645463325252ULL;
+    for (int i = 0; i < n; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        first.limbs[i] = seed;
+    }
+
+    BigUint quot = biguint_new_heap(n);
+    BigUint rem = biguint_new(3);
+    BigUint rem_only = biguint_new(3);
+    BigUint check = biguint_new_heap(n + 1);
+    biguint_divmod(first, second, &quot, &rem);
+    biguint_mod(first, second, &rem_only);
+
+    // first = quot * second + rem, with rem < second
+    biguint_mul(quot, second, &check);
+    biguint_add(check, rem, &check);
+    assert_that(biguint_cmp(check, first) == 0);
+    assert_that(biguint_cmp(rem, second) < 0);
+    assert_that(biguint_cmp(rem, rem_only) == 0);
+
+    biguint_free(&first, &quot, &check);
+}
+
 void test_biguint_div() {
     BigUint first = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
     BigUint second = biguint_new_with_limbs(4, {2919980651337220095ULL, 14019525496019259228ULL, 10995116277ULL, 0});
@@ -256,6 +712,55 @@ void test_biguint_from_string() {
     assert_that(biguint_cmp(result, expected_result) == 0);
 }
 
+void test_biguint_from_dec_invalid() {
+    BigUint result = biguint_new(2);
+
+    assert_that(biguint_from_dec_string("", &result) == -1);
+    assert_that(biguint_from_dec_string("12a4", &result) == -1);
+    assert_that(biguint_from_dec_string("-1", &result) == -1);
+    assert_that(biguint_is_zero(result));
+
+    // 2^128 does not fit, 2^128 - 1 does, and leading zeros do not count towards the length
+    assert_that(biguint_from_dec_string("340282366920938463463374607431768211456", &result) == -1);
+    assert_that(biguint_is_zero(result));
+    assert_that(biguint_from_dec_string("000340282366920938463463374607431768211455", &result) == 0);
+    assert_that(result.limbs[0] == 0xFFFFFFFFFFFFFFFFULL && result.limbs[1] == 0xFFFFFFFFFFFFFFFFULL);
+}
+
+void test_biguint_from_dec() {
+    BigUint result = biguint_new(1);
+    const char *fields = "12345,18446744073709551615";
+
+    assert_that(biguint_from_dec(fields, 5, &result) == 0);
+    assert_that(result.limbs[0] == 12345);
+    assert_that(biguint_from_dec(fields + 6, 20, &result) == 0);
+    assert_that(result.limbs[0] == 18446744073709551615ULL);
+    assert_that(biguint_from_dec(fields, 6, &result) == -1);
+    assert_that(biguint_from_dec(fields, 0, &result) == -1);
+}
+
+void test_biguint_from_string_large() {
+    // 10^6000 + 1 is long enough to be split recursively
+    char *str = malloc(6002);
+    memset(str, '0', 6001);
+    str[0] = '1';
+    str[6000] = '1';
+    str[6001] = '\0';
+
+    BigUint ten = biguint_new_with_limbs(1, {10});
+    BigUint exponent = biguint_new_with_limbs(1, {6000});
+    BigUint expected_result = biguint_new_heap(312);
+    biguint_pow(ten, exponent, &expected_result);
+    expected_result.limbs[0] += 1;
+
+    BigUint result = biguint_new_heap(312);
+    assert_that(biguint_from_dec_string(str, &result) == 0);
+    assert_that(biguint_cmp(result, expected_result) == 0);
+
+    biguint_free(&expected_result, &result);
+    free(str);
+}
+
 void test_biguint_to_string() {
     BigUint number = biguint_new_with_limbs(4, {18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0});
     char *result = biguint_to_dec_string(number);
@@ -265,6 +770,43 @@ void test_biguint_to_string() {
     free(result);
 }
 
+void test_biguint_write_dec() {
+    BigUint number = biguint_new_with_limbs(2, {10000000000000000000ULL, 5});
+    char buffer[32];
+
+    assert_that(biguint_write_dec(number, buffer, sizeof(buffer)) == 21);
+    assert_that(strcmp(buffer, "102233720368547758080") == 0);
+    assert_that(biguint_write_dec(number, buffer, 21) == -1);
+
+    BigUint zero = biguint_new(2);
+    assert_that(biguint_write_dec(zero, buffer, 2) == 1);
+    assert_that(strcmp(buffer, "0") == 0);
+    assert_that(biguint_write_dec(zero, buffer, 1) == -1);
+}
+
+void test_biguint_to_string_large() {
+    // 10^1000 + 1 spans 52 limbs, enough to be split recursively, and its inner zeros have to survive the padding
+    BigUint ten = biguint_new_with_limbs(1, {10});
+    BigUint exponent = biguint_new_with_limbs(1, {1000});
+    BigUint number = biguint_new(53);
+    biguint_pow(ten, exponent, &number);
+    number.limbs[0] += 1;
+
+    char expected_result[1002];
+    memset(expected_result, '0', 1001);
+    expected_result[0] = '1';
+    expected_result[1000] = '1';
+    expected_result[1001] = '\0';
+
+    char *result = biguint_to_dec_string(number);
+    assert_that(strcmp(result, expected_result) == 0);
+    free(result);
+
+    BigUint parsed = biguint_new(53);
+    biguint_from_dec_string(expected_result, &parsed);
+    assert_that(biguint_cmp(parsed, number) == 0);
+}
+
 void test_biguint_from_u64() {
     BigUint result = biguint_new_with_limbs(4, {0});
     biguint_from_u64(9223372036854775808ULL, &result);
@@ -300,6 +842,53 @@ void test_biguint_get_bytes_little_endian() {
     }
 }
 
+void test_biguint_read_write_bytes() {
+    uint8_t bytes[11] = {0, 0, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09};
+    BigUint number = biguint_new(2);
+
+    // leading zeros are skipped, the rest spans a limb and a byte
+    assert_that(biguint_read_bytes_big_endian(bytes, 11, &number) == 0);
+    assert_that(number.limbs[0] == 0x0203040506070809ULL && number.limbs[1] == 0x01);
+
+    uint8_t buffer[11];
+    assert_that(biguint_write_bytes_big_endian(number, buffer, 11) == 0);
+    assert_that(memcmp(buffer, bytes, 11) == 0);
+    assert_that(biguint_write_bytes_big_endian(number, buffer, 8) == -1);
+
+    assert_that(biguint_write_bytes_little_endian(number, buffer, 9) == 0);
+    assert_that(buffer[0] == 0x09 && buffer[7] == 0x02 && buffer[8] == 0x01);
+    BigUint other = biguint_new(2);
+    assert_that(biguint_read_bytes_little_endian(buffer, 9, &other) == 0);
+    assert_that(biguint_cmp(number, other) == 0);
+
+    BigUint small = biguint_new(1);
+    assert_that(biguint_read_bytes_big_endian(bytes, 11, &small) == -1);
+    assert_that(biguint_is_zero(small));
+}
+
+void test_biguint_hex() {
+    BigUint number = biguint_new(2);
+    const char *hex = "0x1F2e3D4c5B6a7980FFee";
+
+    assert_that(biguint_from_hex(hex, strlen(hex), &number) == 0);
+    assert_that(number.limbs[0] == 0x3d4c5b6a7980ffeeULL && number.limbs[1] == 0x1f2e);
+
+    char buffer[21];
+    assert_that(biguint_hex_size(number) == 21);
+    assert_that(biguint_write_hex(number, buffer, sizeof(buffer)) == 20);
+    assert_that(strcmp(buffer, "1f2e3d4c5b6a7980ffee") == 0);
+    assert_that(biguint_write_hex(number, buffer, 20) == -1);
+
+    assert_that(biguint_from_hex("12g4", 4, &number) == -1);
+    assert_that(biguint_from_hex("0x", 2, &number) == -1);
+    assert_that(biguint_from_hex("1123456789abcdef0123456789abcdef0", 33, &number) == -1);
+    assert_that(biguint_from_hex("00000123456789abcdef0123456789abcdef", 36, &number) == 0);
+
+    BigUint zero = biguint_new(1);
+    assert_that(biguint_write_hex(zero, buffer, 2) == 1);
+    assert_that(strcmp(buffer, "0") == 0);
+}
+
 void test_biguint_from_bytes_big_endian() {
     uint8_t bytes[32];
     memset(bytes, 0, 32);
@@ -331,32 +920,62 @@ int main() {
     BEGIN_TEST();
     test(test_biguint_overflow_add);
     test(test_biguint_overflow_add_with_overflow);
+    test(test_biguint_overflow_add_different_sizes);
+    test(test_biguint_len);
+    test(test_biguint_cmp_different_sizes);
     test(test_biguint_add_mod);
     test(test_biguint_overflow_sub);
     test(test_biguint_overflow_sub_with_overflow);
+    test(test_biguint_overflow_sub_truncated);
     test(test_biguint_sub_mod);
     test(test_biguint_overflow_mul);
     test(test_biguint_overflow_mul_with_overflow);
+    test(test_biguint_overflow_sqr);
+    test(test_biguint_sqr_small);
+    test(test_biguint_mul_karatsuba);
+    test(test_biguint_mul_toom3);
+    test(test_biguint_mul_ntt);
+    test(test_biguint_mul_low);
+    test(test_biguint_mul_asm_kernels);
     test(test_biguint_mul_mod);
+    test(test_biguint_mul_mod_ws);
     test(test_biguint_overflow_pow);
     test(test_biguint_overflow_pow_with_overflow);
     test(test_biguint_overflow_pow_mod);
+    test(test_biguint_pow_mod_even_modulus);
+    test(test_biguint_pow_mod_long_exponent);
+    test(test_biguint_pow_mod_batch);
+    test(test_biguint_multi_pow_mod);
+    test(test_biguint_mont_mul);
+    test(test_biguint_mont_sqr);
+    test(test_biguint_barrett_reduce);
+    test(test_biguint_mod_ctx);
     test(test_biguint_bitand);
     test(test_biguint_bitor);
     test(test_biguint_bitxor);
     test(test_biguint_bitnot);
     test(test_biguint_shl);
     test(test_biguint_shr);
+    test(test_biguint_shl_into_other);
     test(test_biguint_divmod_with_rem);
     test(test_biguint_divmod_without_rem);
+    test(test_biguint_divmod_multi_limb_divisor);
+    test(test_biguint_divmod_large_dividend);
     test(test_biguint_div);
     test(test_biguint_mod);
     test(test_biguint_is_even);
     test(test_biguint_from_string);
+    test(test_biguint_from_dec_invalid);
+    test(test_biguint_from_dec);
+    test(test_biguint_from_string_large);
     test(test_biguint_to_string);
+    test(test_biguint_write_dec);
+    test(test_biguint_to_string_large);
     test(test_biguint_from_u64);
     test(test_biguint_from_bytes_little_endian);
     test(test_biguint_get_bytes_little_endian);
+    test(test_biguint_read_write_bytes);
+    test(test_biguint_hex);
     test(test_biguint_from_bytes_big_endian);
     test(test_biguint_get_bytes_big_endian);
     END_TEST();
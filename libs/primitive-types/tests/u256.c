@@ -93,6 +93,39 @@ void test_u256_mul_mod() {
     assert_that(u256_cmp(result, expected_result) == 0);
 }
 
+void test_u256_mul_mod_full_width() {
+    // modulo the secp256k1 field prime, the products need all 8 limbs before being reduced
+    u256 mod = {{18446744069414583343ULL, 18446744073709551615ULL, 18446744073709551615ULL, 18446744073709551615ULL}};
+    u256 first = {{1089357896855742840ULL, 18364758544493064720ULL, 81985529216486895ULL, 16045690984503098046ULL}};
+    u256 second = {{12297829382473034410ULL, 1229782938247303441ULL, 1ULL, 9223372036854775807ULL}};
+    u256 expected_product = {
+        {5864085706623001391ULL, 15102863471595256059ULL, 17931156125594513767ULL, 4395891423563735264ULL}};
+    u256 expected_square = {
+        {5962781687570986765ULL, 17159063368176981992ULL, 10609751484335158710ULL, 14200835873451545471ULL}};
+
+    assert_that(u256_cmp(u256_mul_mod(first, second, mod), expected_product) == 0);
+    assert_that(u256_cmp(u256_sqr_mod(first, mod), expected_square) == 0);
+    assert_that(u256_cmp(u256_mul_mod(first, first, mod), expected_square) == 0);
+}
+
+void test_u256_overflow_sqr() {
+    u256 first = {{18446744073709551615ULL, 0, 0, 0}};
+    u256_overflow_op result = u256_overflow_sqr(first);
+    u256 expected_result = {{1, 18446744073709551614ULL, 0, 0}};
+
+    assert_that(u256_cmp(result.res, expected_result) == 0);
+    assert_that(result.overflow == 0);
+}
+
+void test_u256_sqr_mod() {
+    u256 first = {{18446744073709551615ULL, 18446744073709551615ULL, 1099511627775ULL, 0}};
+    u256 mod = {{987654321, 123456789, 0, 0}};
+    u256 result = u256_sqr_mod(first, mod);
+    u256 expected_result = {{1337155198122044581ULL, 50131304, 0, 0}};
+
+    assert_that(u256_cmp(result, expected_result) == 0);
+}
+
 void test_u256_overflow_pow() {
     u256 first = {{18446744073709551615ULL, 0, 0, 0}};
     u256 second = {{2, 0, 0, 0}};
@@ -293,6 +326,17 @@ void test_u256_get_bytes_big_endian() {
     }
 }
 
+void test_u256_hex() {
+    const char *hex = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F";
+    u256 result;
+    assert_that(u256_from_hex(hex, 64, &result) == 0);
+    assert_that(result.limbs[0] == 0xFFFFFFFEFFFFFC2FULL && result.limbs[3] == 0xFFFFFFFFFFFFFFFFULL);
+
+    char buffer[65];
+    assert_that(u256_write_hex(result, buffer, sizeof(buffer)) == 64);
+    assert_that(strcmp(buffer, "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f") == 0);
+}
+
 int main() {
     BEGIN_TEST();
     test(test_u256_overflow_add);
@@ -304,6 +348,9 @@ int main() {
     test(test_u256_overflow_mul);
     test(test_u256_overflow_mul_with_overflow);
     test(test_u256_mul_mod);
+    test(test_u256_mul_mod_full_width);
+    test(test_u256_overflow_sqr);
+    test(test_u256_sqr_mod);
     test(test_u256_overflow_pow);
     test(test_u256_overflow_pow_with_overflow);
     test(test_u256_overflow_pow_mod);
@@ -325,6 +372,7 @@ int main() {
     test(test_u256_get_bytes_little_endian);
     test(test_u256_from_bytes_big_endian);
     test(test_u256_get_bytes_big_endian);
+    test(test_u256_hex);
     END_TEST();
 
     return 0;
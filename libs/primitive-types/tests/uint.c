@@ -0,0 +1,97 @@
+#include <primitive-types/u1024.h>
+#include <primitive-types/u2048.h>
+#include <primitive-types/u3072.h>
+#include <primitive-types/u384.h>
+#include <primitive-types/u4096.h>
+#include <primitive-types/u512.h>
+#include <utils/test.h>
+
+void test_u384_from_biguint() {
+    BigUint value = biguint_new_with_limbs(8, {1, 2, 3, 4, 5, 6, 7, 8});
+    u384 result = u384_from_biguint(value);
+    u384 expected_result = {{1, 2, 3, 4, 5, 6}};
+
+    assert_that(u384_cmp(result, expected_result) == 0);
+}
+
+void test_u512_overflow_mul() {
+    // (2^512 - 1)^2 = 2^1024 - 2^513 + 1
+    u512 max = u512_bitnot(u512_zero());
+    u512_overflow_op result = u512_overflow_mul(max, max);
+
+    assert_that(u512_cmp(result.res, u512_one()) == 0);
+    assert_that(result.overflow == 1);
+}
+
+void test_u2048_mul_mod() {
+    u2048 first, second, mod;
+    for (int i = 0; i < 32; i++) {
+        first.limbs[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+        second.limbs[i] = ~0ULL - i;
+        mod.limbs[i] = 0xD1B54A32D192ED03ULL ^ (i * 0x2545F4914F6CDD1DULL);
+    }
+    mod.limbs[0] |= 1;
+
+    BigUint expected_result = biguint_new(32);
+    biguint_mul_mod(uint_to_biguint(first), uint_to_biguint(second), uint_to_biguint(mod), &expected_result);
+    u2048 result = u2048_mul_mod(first, second, mod);
+    assert_that(u2048_cmp(result, u2048_from_biguint(expected_result)) == 0);
+
+    biguint_sqr_mod(uint_to_biguint(first), uint_to_biguint(mod), &expected_result);
+    result = u2048_sqr_mod(first, mod);
+    assert_that(u2048_cmp(result, u2048_from_biguint(expected_result)) == 0);
+}
+
+void test_u1024_pow_mod() {
+    u1024 base, exponent, mod;
+    for (int i = 0; i < 16; i++) {
+        base.limbs[i] = 0x9E3779B97F4A7C15ULL * (i + 3);
+        exponent.limbs[i] = 0xD1B54A32D192ED03ULL ^ (i * 0x2545F4914F6CDD1DULL);
+        mod.limbs[i] = ~0ULL - i * 7;
+    }
+
+    // odd moduli run on a stack montgomery context, even ones go through biguint_pow_mod
+    BigUint expected_result = biguint_new(16);
+    for (int parity = 1; parity >= 0; parity--) {
+        mod.limbs[0] = (mod.limbs[0] & ~1ULL) | parity;
+        biguint_pow_mod(uint_to_biguint(base), uint_to_biguint(exponent), uint_to_biguint(mod), &expected_result);
+        u1024 result = u1024_pow_mod(base, exponent, mod);
+        assert_that(u1024_cmp(result, u1024_from_biguint(expected_result)) == 0);
+    }
+}
+
+void test_u4096_shl_shr() {
+    u4096 one = u4096_one();
+    u4096 shifted = u4096_shl(one, 4095);
+
+    assert_that(u4096_bits(shifted) == 4096);
+    assert_that(u4096_cmp(u4096_shr(shifted, 4095), one) == 0);
+    assert_that(u4096_is_zero(u4096_shl(shifted, 1)));
+}
+
+void test_u3072_bytes_big_endian() {
+    uint8_t bytes[384] = {0};
+    bytes[0] = 0x80;
+    bytes[383] = 0x01;
+    u3072 value = u3072_from_bytes_big_endian(bytes);
+
+    assert_that(value.limbs[47] == 0x8000000000000000ULL);
+    assert_that(value.limbs[0] == 1);
+
+    uint8_t buffer[384];
+    u3072_get_bytes_big_endian(buffer, value);
+    assert_that(memcmp(buffer, bytes, 384) == 0);
+}
+
+int main() {
+    BEGIN_TEST();
+    test(test_u384_from_biguint);
+    test(test_u512_overflow_mul);
+    test(test_u2048_mul_mod);
+    test(test_u1024_pow_mod);
+    test(test_u4096_shl_shr);
+    test(test_u3072_bytes_big_endian);
+    END_TEST();
+
+    return 0;
+}